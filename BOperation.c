@@ -17,6 +17,39 @@
  *      - Bugfix en la división en general + Prueba integrada
  *    v1.23
  *      - Cambio en el cálculo de getMemorySize.
+ *    v1.25
+ *      - Nueva función divmod (cociente y resto con una sola división).
+ *    v1.26
+ *      - Aritmética modular con contexto de Montgomery: montInit, modmul, modsqr y modpow.
+ *    v1.27
+ *      - Contexto de Barrett para reducir por un mismo módulo: barrettInit y bmod.
+ *    v1.28
+ *      - Nueva función bipowBI (exponente BigInteger).
+ *    v1.29
+ *      - nqrt usa el método de Newton sobre limbs.
+ *    v1.30
+ *      - Las copias de operate solo mueven las cifras usadas (BIcopy).
+ *    v1.31
+ *      - Motor reentrante: el punto decimal se guarda en memory (getPoint(m)) y no se llama a _BI_initialize.
+ *    v1.32
+ *      - Nueva función operate (operación por lotes): reparte un array de operation entre varios hilos,
+ *        cada uno con su memory, con robo de trabajo. Cada operación deja su código de error en status.
+ *    v1.33
+ *      - mul puede repartir una multiplicación grande entre varios hilos (setThreads).
+ *    v1.34
+ *      - Nuevas funciones gcd, xgcd y modinv.
+ *    v1.35
+ *      - Nuevas funciones isProbablePrime y primeSieve.
+ *    v1.36
+ *      - Nuevas funciones toStringN (toString sobre un buffer acotado) y getStrLen.
+ *    v1.37
+ *      - Suma y resta usan núcleos de cifras (SSE2, AVX2 o AVX-512), elegidos una vez según la CPU.
+ *    v1.38
+ *      - Acumuladores para sumar muchos números o productos propagando los acarreos una sola vez:
+ *        accInit, accAdd, accSub, accMul, accDot y accGet.
+ *    v1.39
+ *      - Operando fijo (BIT) para multiplicar y dividir: bitInit, bitMul, bitDvs y bitDivmod.
+ *      - Quitamos biBIT de memory (no se usaba).
  */
 #include "stdio.h"
 #include "stdlib.h"
@@ -26,6 +59,48 @@
 #include "BigInteger.h"
 #include "BigDouble.h"
 
+//hilos para operate
+#if defined(_WIN32)
+#include "windows.h"
+#define BO_THREAD_FN DWORD WINAPI
+#define BO_THREAD_START(t, f, a) (((t) = CreateThread(NULL, 0, f, a, 0, NULL)) == NULL)
+#define BO_THREAD_JOIN(t) (WaitForSingleObject(t, INFINITE), CloseHandle(t))
+#define BO_LOCK_INIT(l) InitializeCriticalSection(&(l))
+#define BO_LOCK(l) EnterCriticalSection(&(l))
+#define BO_UNLOCK(l) LeaveCriticalSection(&(l))
+#define BO_LOCK_FREE(l) DeleteCriticalSection(&(l))
+typedef HANDLE BOthread;
+typedef CRITICAL_SECTION BOlock;
+#else
+#include "pthread.h"
+#define BO_THREAD_FN void*
+#define BO_THREAD_START(t, f, a) pthread_create(&(t), NULL, f, a)
+#define BO_THREAD_JOIN(t) pthread_join(t, NULL)
+#define BO_LOCK_INIT(l) pthread_mutex_init(&(l), NULL)
+#define BO_LOCK(l) pthread_mutex_lock(&(l))
+#define BO_UNLOCK(l) pthread_mutex_unlock(&(l))
+#define BO_LOCK_FREE(l) pthread_mutex_destroy(&(l))
+typedef pthread_t BOthread;
+typedef pthread_mutex_t BOlock;
+#endif
+
+//cola de operaciones de un hilo: [lo, hi)
+typedef struct BOqueue {
+  BOlock lock;
+  int lo;
+  int hi;
+} BOqueue;
+
+//hilo de operate
+typedef struct BOworker {
+  BOthread th;
+  operation* ops;
+  BOqueue* queue;
+  int id;
+  int threads;
+  memory m;
+} BOworker;
+
 static int validate = 
 #ifdef CVALIDATE
   CVALIDATE;
@@ -33,6 +108,9 @@ static int validate =
   1;
 #endif
 
+//1 si el hilo está dentro de operate: showError guarda el código en lugar de parar
+static BI_TLS int batch;
+
 /*
  * Función dummyOp1. Función vacía para usar en cal2op
  */
@@ -96,6 +174,12 @@ static void decimalize(void* va) {
   if (dpos < 0)
     return;
 
+  //el signo va en la primera cifra, que pasará a ser un 0. Lo guardamos en sig
+  if (((BigDouble*)va)->n[((BigDouble*)va)->count] < 0) {
+    ((BigDouble*)va)->n[((BigDouble*)va)->count] *= -1;
+    ((BigDouble*)va)->sig = -1;
+  }
+
   if (((BigDouble*)va)->count + dpos > MAX_LENGTH) {
     //desplazamos dpos posiciones, borrando así dpos posiciones sobrantes.
     for (i = 0; i <= ((BigDouble*)va)->count - dpos; i++)
@@ -129,7 +213,6 @@ static void cal2op(void* va, void* vb, void* m, char k, int* ret) {
   int adj = 0;
   int adi = 0;
   int dvi = 0;
-  int dvj = 0;
 
   //asignaciones iniciales
   cal = dummyOp1;
@@ -181,20 +264,20 @@ static void cal2op(void* va, void* vb, void* m, char k, int* ret) {
     //copiamos los datos ajustarlos
     if (ka == 'i') {
       //a es int
-      memcpy(((memory*)m)->a, va, sizeof(BigInteger));
+      BIcopy(((memory*)m)->a, va);
 
       if (kb == 'd') {
         //operando int : dou. Retiramos de b las cifras decimales
-        memcpy(((memory*)m)->b, vb, sizeof(BigInteger));
+        BIcopy(((memory*)m)->b, vb);
         adjustData(((memory*)m)->b, ((BigDouble*)vb)->cpos, 0);
       }
     } else if (ka == 'd') {
       //a es double
-      memcpy(((memory*)m)->a, va, sizeof(BigInteger));
+      BIcopy(((memory*)m)->a, va);
 
       if (kb == 'd') {
         //b es double
-        memcpy(((memory*)m)->b, vb, sizeof(BigInteger));
+        BIcopy(((memory*)m)->b, vb);
 
         if (((BigDouble*)va)->cpos > ((BigDouble*)vb)->cpos) {
           //a tiene más cifras decimales. Añadimos la diferencia de decimales a b
@@ -210,10 +293,13 @@ static void cal2op(void* va, void* vb, void* m, char k, int* ret) {
 
           //indicamos el ajuste de decimales
           adj = ((struct BigDouble*)vb)->cpos;
+        } else if (k == 'm') {
+          //mismos decimales. En la multiplicación también guardamos el ajuste
+          adj = ((struct BigDouble*)va)->cpos;
         }
       } else if (kb == 'i') {
         //operando dou : int. Añadimos cifras al int
-        memcpy(((memory*)m)->b, vb, sizeof(BigInteger));
+        BIcopy(((memory*)m)->b, vb);
         adjustData(((memory*)m)->b, ((BigDouble*)va)->cpos, 1);
 
         //en la multiplicación necesitamos guardar el ajuste de decimales
@@ -222,8 +308,8 @@ static void cal2op(void* va, void* vb, void* m, char k, int* ret) {
       }
 
       if (k == 'd') {
-        adj = -1;
-        dvj = ((BigInteger*)va)->count;
+        //a y b tienen los mismos decimales, así que adj solo guarda las cifras que añadimos a a
+        adj = 0;
 
         //estamos con un double. Si estamos dividiendo tenemos que validar que es factible a < b
         if (((BigInteger*)((memory*)m)->a)->count < ((BigInteger*)((memory*)m)->b)->count) {
@@ -255,65 +341,40 @@ static void cal2op(void* va, void* vb, void* m, char k, int* ret) {
 
       //copiamos a a va
       if (ka == 'i')
-        memcpy(va, ((memory*)m)->a, sizeof(BigInteger));
+        BIcopy(va, ((memory*)m)->a);
       else if (ka == 'd') {
         //primero restauramos la posición decimal
         adi = ((BigDouble*)va)->cpos;
 
         memcpy(va, ((memory*)m)->a, sizeof(BigDouble));
 
+        //el signo está en la primera cifra (decimalize lo pasa a sig si hace falta)
+        ((BigDouble*)va)->sig = 0;
+
         //si estamos multiplicando, el contador decimal será el doble debido al ajuste previo
         if (k == 'm')
           adj *= 2;
 
         if (k == 'd') {
           /*
-           * Si getPoint retorna -1 o -2 significa que no ha tratado el dato (p. ej. estamos dividiendo a/1)
-           * por tanto, no hace falta hacer ningún tratamiento
+           * El cociente tiene getPoint(m) decimales (-1 o -2 si la división no se ha hecho, p. ej. a / 1
+           * o a = b), y a se ha multiplicado por 10^adj para que a >= b
            */
-          if(getPoint() >= 0 || adj > 0){
-            //el ajuste decimal de la división es distinto.
-            ((BigDouble*)va)->cpos = (((BigDouble*)va)->count - getPoint()) + adj;
-
-            //puede que el resultado tras la transformación haya dado lugar a un getPoint() negativo
-            if (getPoint() == -1)
-              --((BigDouble*)va)->cpos;
-            else if (getPoint() == -2)
-              ((BigDouble*)va)->cpos -= 2;
-
-            //si cpos >= count, el resultado es 0,n. Lo pasamos a modo negativo para que decimalize lo trate
-            if (((BigDouble*)va)->cpos > ((BigDouble*)va)->count) {
-              //if (((BigDouble*)va)->cpos > ((BigDouble*)va)->count && ((BigDouble*)va)->count > 0)
-              if (((BigDouble*)va)->cpos > dvj && dvj > 0)
-                ((BigDouble*)va)->cpos = ((BigDouble*)va)->count - ((BigDouble*)va)->cpos - 1;
-  
-              //if (((BigDouble*)va)->cpos > ((BigDouble*)va)->count && ((BigDouble*)va)->count == 0)
-              if (((BigDouble*)va)->cpos > dvj && dvj == 0)
-                ((BigDouble*)va)->cpos = ((BigDouble*)va)->count - ((BigDouble*)va)->cpos;
-            }
-
-            //si cpos == count y hemos incrementado para igualar, dividimos entre 10
-            if (((BigDouble*)va)->cpos == ((BigDouble*)va)->count && dvi == 2)
-              ((BigDouble*)va)->cpos = -1;
-  
-            //si cpos es negativo o es mayor que count, es que es 0,n
-            if (((BigDouble*)va)->cpos < 0)
-              decimalize(va);
-            /*else {
-              //si cpos = longitud, es que no hay decimales. Lo aislamos de decimalize porque en ese caso count = cpos
-              if (((BigDouble*)va)->cpos == ((BigDouble*)va)->count)
-                ((BigDouble*)va)->cpos = 0;
-            }*/
-          } else {
-            //la división no ha hecho ningún tratamiento
-            if (getPoint() == -1) {
-              //respetamos los decimales originales
-              ((BigDouble*)va)->cpos = adi;
-            } else {
-              //el resultado es 0 o 1, y los decimales son 0
-              ((BigDouble*)va)->cpos = 0;
-            }
-          }
+          ((BigDouble*)va)->cpos = adj;
+
+          if (getPoint(m) > 0)
+            ((BigDouble*)va)->cpos += getPoint(m);
+
+          //si el cociente es 0, no hay decimales
+          if (((BigDouble*)va)->count == 0 && ((BigDouble*)va)->n[0] == 0)
+            ((BigDouble*)va)->cpos = 0;
+
+          //si cpos > count, el resultado es 0,n. Lo pasamos a modo negativo para que decimalize lo trate
+          if (((BigDouble*)va)->cpos > ((BigDouble*)va)->count)
+            ((BigDouble*)va)->cpos = ((BigDouble*)va)->count - ((BigDouble*)va)->cpos;
+
+          if (((BigDouble*)va)->cpos < 0)
+            decimalize(va);
         } else {
           //reajustamos el valor decimal
           if (adj > 0)
@@ -321,8 +382,15 @@ static void cal2op(void* va, void* vb, void* m, char k, int* ret) {
           else
             ((BigDouble*)va)->cpos = adi;
 
-          //para la resta, reajustamos los decimales (si la parte entera de a = parte entera de b)
-          if (k == 's') {
+          /*
+           * para la resta (si la parte entera de a = parte entera de b) y la multiplicación (si el resultado
+           * es 0,n), reajustamos los decimales: count no incluye los 0's de la izquierda
+           */
+          if (k == 's' || k == 'm') {
+            //si el resultado es 0, no hay decimales
+            if (((BigDouble*)va)->count == 0 && ((BigDouble*)va)->n[0] == 0)
+              ((BigDouble*)va)->cpos = 0;
+
             if (((BigDouble*)va)->cpos > ((BigDouble*)va)->count)
               ((BigDouble*)va)->cpos = ((BigDouble*)va)->count - ((BigDouble*)va)->cpos;
 
@@ -425,6 +493,402 @@ void dvs(void* va, void* vb, void* m) {
   cal2op(va, vb, m, 'd', NULL);
 }
 
+/*
+ * Función divmod. Función para obtener cociente y resto con una sola división.
+ *
+ * Simula las operaciones q = a / b y r = a % b. El cociente se trunca hacia 0 y el resto
+ * tiene el signo de a (como en C).
+ */
+void divmod(void* vq, void* vr, void* va, void* vb, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vb) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vb);
+    }
+
+    //delegamos en la función estática
+    sDivmod(vq, vr, va, vb, m);
+  }
+}
+
+/*
+ * Función bitInit.
+ *
+ * Fija b en un BIT (de getBITSize() bytes): sus limbs y su contexto de divisor se calculan una
+ * sola vez para bitMul, bitDvs y bitDivmod.
+ */
+void bitInit(void* vt, void* vb, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(vb) == 'i') {
+    //validamos puntero
+    if (validate == 1)
+      validateBI(vb);
+
+    //delegamos en la función estática
+    sBitInit(vt, vb, m);
+  }
+}
+
+/*
+ * Función bitMul.
+ *
+ * Realiza a *= b con el BIT de b (si b ha cambiado, el BIT se vuelve a calcular).
+ */
+void bitMul(void* va, void* vb, void* vt, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vb) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vb);
+    }
+
+    //delegamos en la función estática
+    sBitMul(va, vb, vt, m);
+  }
+}
+
+/*
+ * Función bitDvs.
+ *
+ * Realiza a /= b con el BIT de b (si b ha cambiado, el BIT se vuelve a calcular).
+ */
+void bitDvs(void* va, void* vb, void* vt, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vb) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vb);
+    }
+
+    //delegamos en la función estática
+    sBitDvs(va, vb, vt, m);
+  }
+}
+
+/*
+ * Función bitDivmod.
+ *
+ * Simula q = a / b y r = a % b (como divmod) con el BIT de b.
+ */
+void bitDivmod(void* vq, void* vr, void* va, void* vb, void* vt, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vb) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vb);
+    }
+
+    //delegamos en la función estática
+    sBitDivmod(vq, vr, va, vb, vt, m);
+  }
+}
+
+/*
+ * Función barrettInit.
+ *
+ * Carga el módulo n en un contexto de Barrett (de getBarrettSize() bytes) para usarlo en bmod.
+ */
+void barrettInit(void* vc, void* vn, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(vn) == 'i') {
+    //validamos puntero
+    if (validate == 1)
+      validateBI(vn);
+
+    //delegamos en la función estática
+    sBarrettInit(vc, vn, m);
+  }
+}
+
+/*
+ * Función bmod.
+ *
+ * Realiza a = |a| mod n, siendo n el módulo del contexto de Barrett.
+ */
+void bmod(void* va, void* vc, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i') {
+    //validamos puntero
+    if (validate == 1)
+      validateBI(va);
+
+    //delegamos en la función estática
+    sBmod(va, vc, m);
+  }
+}
+
+/*
+ * Función montInit.
+ *
+ * Carga el módulo n en un contexto de Montgomery (de getMontSize() bytes) para usarlo
+ * en modmul, modsqr y modpow.
+ */
+void montInit(void* vc, void* vn, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(vn) == 'i') {
+    //validamos puntero
+    if (validate == 1)
+      validateBI(vn);
+
+    //delegamos en la función estática
+    sMontInit(vc, vn, m);
+  }
+}
+
+/*
+ * Función modmul.
+ *
+ * Realiza a = a * b mod n, siendo n el módulo del contexto.
+ */
+void modmul(void* va, void* vb, void* vc, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vb) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vb);
+    }
+
+    //delegamos en la función estática
+    sModmul(va, vb, vc, m);
+  }
+}
+
+/*
+ * Función modsqr.
+ *
+ * Realiza a = a^2 mod n, siendo n el módulo del contexto.
+ */
+void modsqr(void* va, void* vc, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i') {
+    //validamos puntero
+    if (validate == 1)
+      validateBI(va);
+
+    //delegamos en la función estática
+    sModsqr(va, vc, m);
+  }
+}
+
+/*
+ * Función modpow.
+ *
+ * Realiza a = a^e mod n, siendo n el módulo del contexto. El exponente es un BigInteger.
+ */
+void modpow(void* va, void* ve, void* vc, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(ve) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(ve);
+    }
+
+    //delegamos en la función estática
+    sModpow(va, ve, vc, m);
+  }
+}
+
+/*
+ * Función gcd.
+ *
+ * Realiza a = mcd(a, b). El resultado siempre es positivo.
+ */
+void gcd(void* va, void* vb, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vb) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vb);
+    }
+
+    //delegamos en la función estática
+    sGcd(va, vb, m);
+  }
+}
+
+/*
+ * Función xgcd.
+ *
+ * Realiza g = mcd(a, b) y obtiene x, y tales que x * a + y * b = g.
+ */
+void xgcd(void* vg, void* vx, void* vy, void* va, void* vb, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vb) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vb);
+    }
+
+    //delegamos en la función estática
+    sXgcd(vg, vx, vy, va, vb, m);
+  }
+}
+
+/*
+ * Función modinv.
+ *
+ * Realiza a = a^-1 mod n. Si a y n no son coprimos, a no cambia y se da el error 13.
+ */
+void modinv(void* va, void* vn, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vn) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vn);
+    }
+
+    //delegamos en la función estática
+    sModinv(va, vn, m);
+  }
+}
+
+/*
+ * Función isProbablePrime.
+ *
+ * Devuelve 1 si a es primo (o probable primo) y 0 si no lo es. rounds añade rondas de Miller-Rabin
+ * al test de Baillie-PSW.
+ */
+int isProbablePrime(void* va, int rounds, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) != 'i')
+    return 0;
+
+  //validamos punteros
+  if (validate == 1)
+    validateBI(va);
+
+  //delegamos en la función estática
+  return sIsPrime(va, rounds, m);
+}
+
+/*
+ * Función primeSieve.
+ *
+ * Comprueba el rango a, a + 1, ..., a + len - 1 (res[i] vale 1 si a + i es primo). Devuelve cuántos
+ * primos hay en el rango.
+ */
+int primeSieve(void* va, int len, char* res, int rounds, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) != 'i')
+    return 0;
+
+  //validamos punteros
+  if (validate == 1) {
+    validateBI(va);
+
+    if (res == NULL) {
+      showError(13);
+      return 0;
+    }
+  }
+
+  //delegamos en la función estática
+  return sPrimeSieve(va, len, res, rounds, m);
+}
+
+/*
+ * Función accInit.
+ *
+ * Pone a 0 un acumulador (de getAccSize() bytes).
+ */
+void accInit(void* vc) {
+  lAccInit((BLacc*)vc);
+}
+
+/*
+ * Función accAdd.
+ *
+ * Realiza c += a sobre el acumulador. Los acarreos no se propagan hasta accGet.
+ */
+void accAdd(void* vc, void* va, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i') {
+    //validamos puntero
+    if (validate == 1)
+      validateBI(va);
+
+    //delegamos en la función estática
+    sAccAdd(vc, va, 0, m);
+  }
+}
+
+/*
+ * Función accSub.
+ *
+ * Realiza c -= a sobre el acumulador.
+ */
+void accSub(void* vc, void* va, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i') {
+    //validamos puntero
+    if (validate == 1)
+      validateBI(va);
+
+    //delegamos en la función estática
+    sAccAdd(vc, va, -1, m);
+  }
+}
+
+/*
+ * Función accMul.
+ *
+ * Realiza c += a * b sobre el acumulador.
+ */
+void accMul(void* vc, void* va, void* vb, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(vb) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(vb);
+    }
+
+    //delegamos en la función estática
+    sAccMul(vc, va, vb, m);
+  }
+}
+
+/*
+ * Función accDot.
+ *
+ * Realiza c += a[0] * b[0] + ... + a[n - 1] * b[n - 1] sobre el acumulador (va y vb son arrays
+ * de n BigInteger).
+ */
+void accDot(void* vc, void* va, void* vb, int n, void* m) {
+  int i = 0;
+
+  //validamos punteros
+  if (validate == 1)
+    for (; i < n; i++) {
+      validateBI((BigInteger*)va + i);
+      validateBI((BigInteger*)vb + i);
+    }
+
+  //delegamos en la función estática
+  sAccDot(vc, va, vb, n, m);
+}
+
+/*
+ * Función accGet.
+ *
+ * Propaga los acarreos del acumulador y deja su valor en a. El acumulador lo conserva, así que
+ * se puede seguir sumando.
+ */
+void accGet(void* va, void* vc, void* m) {
+  //delegamos en la función estática
+  sAccGet(va, vc, m);
+}
+
 /*
  * Función nqrt.
  *
@@ -466,33 +930,230 @@ void bipow(void* va, int p, void* m) {
 }
 
 /*
-void operate(int count, ...) {
-  va_list pa;
-  va_start(pa, count);
-  
+ * Función bipowBI.
+ *
+ * Realiza a = a^e, siendo e un BigInteger.
+ */
+void bipowBI(void* va, void* ve, void* m) {
+  //de momento, solo funciona para integers
+  if (getKind(va) == 'i' && getKind(ve) == 'i') {
+    //validamos punteros
+    if (validate == 1) {
+      validateBI(va);
+      validateBI(ve);
+    }
+
+    //delegamos en la función estática
+    sBipowBI(va, ve, m);
+  }
+}
+
+/*
+ * Función runOp.
+ *
+ * Ejecuta una operación de operate con la memoria m y guarda su código de error
+ */
+static void runOp(operation* o, void* m) {
+  setReturnCode(0);
+
+  if (o->va == NULL || (o->vb == NULL && o->op != 'b' && o->op != 'q')) {
+    o->status = 12;
+    return;
+  }
+
+  if (o->op == 'a' || o->op == 's' || o->op == 'm' || o->op == 'd' || o->op == 'e')
+    cal2op(o->va, o->vb, m, o->op, o->ret);
+  else if (o->vc == NULL)
+    setReturnCode(13);
+  else if (o->op == 'b')
+    bmod(o->va, o->vc, m);
+  else if (o->op == 'x')
+    modmul(o->va, o->vb, o->vc, m);
+  else if (o->op == 'q')
+    modsqr(o->va, o->vc, m);
+  else if (o->op == 'p')
+    modpow(o->va, o->vb, o->vc, m);
+  else
+    setReturnCode(97);
+
+  o->status = getReturnCode();
+}
+
+/*
+ * Función takeOp.
+ *
+ * Saca la siguiente operación de la cola de un hilo (por abajo). Devuelve -1 si está vacía
+ */
+static int takeOp(void* vq) {
+  BOqueue* q = (BOqueue*)vq;
+  int ret = -1;
+
+  BO_LOCK(q->lock);
+
+  if (q->lo < q->hi)
+    ret = q->lo++;
+
+  BO_UNLOCK(q->lock);
+
+  return ret;
+}
+
+/*
+ * Función stealOp.
+ *
+ * Cuando la cola del hilo se vacía, roba la mitad alta de la cola de otro hilo
+ * y devuelve la primera operación robada. Devuelve -1 si no queda trabajo.
+ */
+static int stealOp(void* vw) {
+  BOworker* w = (BOworker*)vw;
+  BOqueue* v;
+  int i = 1;
+  int lo;
+  int hi;
+
+  for (; i < w->threads; i++) {
+    v = w->queue + (w->id + i) % w->threads;
+
+    BO_LOCK(v->lock);
+
+    hi = v->hi;
+    lo = hi - (hi - v->lo) / 2;
+
+    //si solo queda una, nos la llevamos
+    if (lo == hi && v->lo < hi)
+      lo = hi - 1;
+
+    v->hi = lo;
+
+    BO_UNLOCK(v->lock);
+
+    if (lo < hi) {
+      //la primera es nuestra, el resto queda en nuestra cola para que otros puedan robarla
+      BO_LOCK(w->queue[w->id].lock);
+
+      w->queue[w->id].lo = lo + 1;
+      w->queue[w->id].hi = hi;
+
+      BO_UNLOCK(w->queue[w->id].lock);
+
+      return lo;
+    }
+  }
+
+  return -1;
+}
+
+/*
+ * Función worker.
+ *
+ * Bucle de un hilo de operate: vacía su cola y después roba de las demás.
+ * Los errores quedan en el status de cada operación, en lugar de parar la ejecución.
+ */
+static BO_THREAD_FN worker(void* vw) {
+  BOworker* w = (BOworker*)vw;
+  int i;
+
+  batch = 1;
+
+  for (;;) {
+    i = takeOp(w->queue + w->id);
+
+    if (i < 0)
+      i = stealOp(w);
+
+    if (i < 0)
+      break;
+
+    runOp(w->ops + i, &w->m);
+  }
+
+  batch = 0;
+
+  return 0;
+}
+
+/*
+ * Función operate. Operación por lotes.
+ *
+ * Ejecuta count operaciones independientes repartiéndolas entre threads hilos (el que llama
+ * es uno de ellos). Cada hilo tiene su propia memory, y cuando termina su parte roba trabajo
+ * a los demás, así que las operaciones largas no dejan hilos parados.
+ *
+ * Cada operación deja su código de error en status (0 = OK) sin parar la ejecución.
+ * Devuelve el número de operaciones con error.
+ *
+ * Las operaciones deben ser independientes: va no se puede repetir entre operaciones, y vb
+ * solo se puede compartir en mul, dvs, equals y modulares (add y sub pueden cambiar su signo).
+ */
+int operate(operation* ops, int count, int threads) {
+  BOworker* w;
+  BOqueue* q;
   int i = 0;
-  void* cal = malloc(sizeof(operation));
+  int ret = 0;
+  int code = getReturnCode();
+  int mode = batch;
+
+  if (ops == NULL || count <= 0)
+    return 0;
+
+  if (threads < 1)
+    threads = 1;
 
-  if (cal == NULL){
+  if (threads > count)
+    threads = count;
+
+  w = malloc(sizeof(BOworker) * threads);
+  q = malloc(sizeof(BOqueue) * threads);
+
+  if (w == NULL || q == NULL) {
+    free(w);
+    free(q);
     showError(12);
-    return;
+    return -1;
   }
 
-  for (i = 0; i < count; i++) {
-    //copiamos el operation que nos envían
-    memcpy(cal, (void*)va_arg(pa, size_t), sizeof(operation));
+  //repartimos las operaciones en bloques contiguos
+  for (; i < threads; i++) {
+    q[i].lo = (int)((long long)count * i / threads);
+    q[i].hi = (int)((long long)count * (i + 1) / threads);
+    BO_LOCK_INIT(q[i].lock);
+
+    w[i].ops = ops;
+    w[i].queue = q;
+    w[i].id = i;
+    w[i].threads = threads;
+    init((void**)&w[i].m);
+  }
+
+  //el hilo 0 es el que llama
+  for (i = 1; i < threads; i++)
+    if (BO_THREAD_START(w[i].th, worker, w + i) != 0)
+      w[i].threads = 0;
+
+  worker(w);
+
+  for (i = 1; i < threads; i++)
+    if (w[i].threads != 0)
+      BO_THREAD_JOIN(w[i].th);
 
-    //llamamos al motor de operaciones
-    cal2op(((operation*)cal)->va, ((operation*)cal)->vb, ((operation*)cal)->m, ((operation*)cal)->op, ((operation*)cal)->ret);
+  for (i = 0; i < threads; i++) {
+    BO_LOCK_FREE(q[i].lock);
+    freeMemory(&w[i].m);
   }
 
-  //cerramos
-  va_end(pa);
+  free(w);
+  free(q);
 
-  //liberamos memoria
-  free(cal);
+  for (i = 0; i < count; i++)
+    if (ops[i].status != 0)
+      ++ret;
+
+  //restauramos el estado del hilo que llama
+  batch = mode;
+  setReturnCode(code);
+
+  return ret;
 }
-*/
 
 /*
  * Función biSig.
@@ -553,6 +1214,12 @@ void showError(int k) {
 #if BI_SERVICE == 1
   setReturnCode(k);
 #else
+  //dentro de operate, el error queda en el status de la operación
+  if (batch == 1) {
+    setReturnCode(k);
+    return;
+  }
+
   if (k == 1)
     printf("Error. Limite alcanzado");
   else if (k == 2)
@@ -577,6 +1244,8 @@ void showError(int k) {
     printf("Error. Puntero erróneo en add");
   else if (k == 12)
     printf("Error. Puntero erróneo en operate");
+  else if (k == 13)
+    printf("Error. Módulo o puntero erróneo en aritmética modular");
   else if (k == 90)
     printf("Error. Puntero erróneo en calc");
   else if (k == 97)
@@ -597,10 +1266,52 @@ void showError(int k) {
 /*
  * Función iniStr.
  *
- * Reserva memoria para un char, para usarlo en toString.
+ * Reserva memoria para un char, para usarlo en toString (MAX_LENGTH dígitos, signo, coma y '\0').
  */
 void iniStr(char** dst) {
-  *dst = malloc(sizeof(char) * MAX_LENGTH + 3);
+  *dst = malloc(sizeof(char) * (MAX_LENGTH + 3));
+}
+
+/*
+ * Función getStrLen.
+ *
+ * Devuelve los caracteres que escribe toString (con el signo y la coma, sin el '\0').
+ */
+int getStrLen(void* va) {
+  int m = ((BigInteger*)va)->count;
+  int len = m + 1;
+
+  if (getKind(va) == 'd') {
+    if (((BigDouble*)va)->n[m] < 0 || ((BigDouble*)va)->sig == -1)
+      ++len;
+
+    if (((BigDouble*)va)->cpos > 0 && ((BigDouble*)va)->cpos <= m + 1)
+      ++len;
+  } else if (((BigInteger*)va)->n[m] < 0)
+    ++len;
+
+  return len;
+}
+
+/*
+ * Función toStringN.
+ *
+ * Como toString, pero dst tiene sitio para size caracteres ('\0' incluido). Devuelve los caracteres
+ * del número (como getStrLen); si no caben, en dst solo se deja el '\0'.
+ */
+int toStringN(void* vb, char* dst, int size) {
+  int len = getStrLen(vb);
+
+  if (len >= size) {
+    if (size > 0)
+      dst[0] = '\0';
+
+    return len;
+  }
+
+  toString(vb, dst);
+
+  return len;
 }
 
 /*
@@ -697,50 +1408,81 @@ static char getKind(void* a) {
  * Arranca el motor de BigInteger.
  */
 void init(void** m) {
+  int i = 0;
+
   //suma
   ((memory*)m)->vt = malloc(sizeof(BigInteger));
 
   //resta
   ((memory*)m)->stmp = malloc(sizeof(BigInteger));
 
-  //multiplicación
-  ((memory*)m)->mpart = malloc(sizeof(BigInteger));
-  ((memory*)m)->mret = malloc(sizeof(BigInteger));
-  ((memory*)m)->mzero = malloc(sizeof(BigInteger));
-  ((memory*)m)->mone = malloc(sizeof(BigInteger));
-  ((memory*)m)->mtmp = malloc(sizeof(BigInteger));
-
   //division
-  ((memory*)m)->done = malloc(sizeof(BigInteger));
-  ((memory*)m)->dtmp = malloc(sizeof(BigInteger));
-  ((memory*)m)->dret = malloc(sizeof(BigInteger));
   ((memory*)m)->dTemp = malloc(sizeof(BigInteger));
-  ((memory*)m)->biTemp = malloc(sizeof(BigInteger));
 
   //raiz
-  ((memory*)m)->sret = malloc(sizeof(BigInteger));
-  ((memory*)m)->sraw = malloc(sizeof(BigInteger));
-  ((memory*)m)->sbase = malloc(sizeof(BigInteger));
-  ((memory*)m)->szero = malloc(sizeof(BigInteger));
+  ((memory*)m)->lsscr = malloc(sizeof(BLlimb) * lRootScratch(L_MAX_LENGTH));
 
   //potencia
   ((memory*)m)->bres = malloc(sizeof(BigInteger));
-  ((memory*)m)->btmp = malloc(sizeof(BigInteger));
-
-  //append
-  ((memory*)m)->aaux = malloc(sizeof(BigInteger));
-
-  //BIT
-  ((memory*)m)->biBIT = malloc(sizeof(BIT));
+  ((memory*)m)->btmp = malloc(sizeof(BigInteger) * (1 << (BIPOW_WINDOW - 1)));
+
+  //motor de limbs
+  ((memory*)m)->la = malloc(sizeof(BLlimb) * L_MAX_LENGTH);
+  ((memory*)m)->lb = malloc(sizeof(BLlimb) * L_MAX_LENGTH);
+  ((memory*)m)->lr = malloc(sizeof(BLlimb) * (L_MAX_LENGTH * 2 + 2));
+  ((memory*)m)->lscr = malloc(sizeof(BLlimb) * (lScratch(L_MAX_LENGTH) + 1));
+  ((memory*)m)->ld = malloc(sizeof(BLlimb) * (L_MAX_LENGTH * 2 + 2));
+  ((memory*)m)->ldscr = malloc(sizeof(BLlimb) * lDivScratch(L_MAX_LENGTH * 2 + 2, L_MAX_LENGTH));
+  ((memory*)m)->lmscr = malloc(sizeof(BLlimb) * (lMontScratch(L_MAX_LENGTH, L_MAX_LENGTH) + lBarrettScratch(L_MAX_LENGTH, 0)));
+  ((memory*)m)->lgscr = malloc(sizeof(BLlimb) * lGcdScratch(L_MAX_LENGTH));
+  ((memory*)m)->lpscr = malloc(sizeof(BLlimb) * lPrimeScratch(L_MAX_LENGTH));
 
   //cal2op
-  ((memory*)m)->a = malloc(sizeof(BigInteger));
-  ((memory*)m)->b = malloc(sizeof(BigInteger));
+  ((memory*)m)->a = malloc(sizeof(BigDouble));
+  ((memory*)m)->b = malloc(sizeof(BigDouble));
   
-  //valores comunes
-  _BI_initialize();
+  //punto decimal
+  ((memory*)m)->point = 0;
+
+  //hilos de la multiplicación
+  ((memory*)m)->threads = MUL_THREADS;
 
   BImemcpy(((memory*)m)->vt, 2);
+
+  //los valores de trabajo empiezan a 0, así BIcopy y BIzero solo limpian las cifras usadas
+  BImemcpy(((memory*)m)->stmp, 0);
+  BImemcpy(((memory*)m)->dTemp, 0);
+  BImemcpy(((memory*)m)->bres, 0);
+  BImemcpy(((memory*)m)->a, 0);
+  BImemcpy(((memory*)m)->b, 0);
+
+  for (; i < (1 << (BIPOW_WINDOW - 1)); i++)
+    BImemcpy((BigInteger*)((memory*)m)->btmp + i, 0);
+}
+
+/*
+ * Función freeMemory
+ *
+ * Libera la memoria reservada por init.
+ */
+static void freeMemory(void* m) {
+  free(((memory*)m)->vt);
+  free(((memory*)m)->stmp);
+  free(((memory*)m)->dTemp);
+  free(((memory*)m)->lsscr);
+  free(((memory*)m)->bres);
+  free(((memory*)m)->btmp);
+  free(((memory*)m)->la);
+  free(((memory*)m)->lb);
+  free(((memory*)m)->lr);
+  free(((memory*)m)->lscr);
+  free(((memory*)m)->ld);
+  free(((memory*)m)->ldscr);
+  free(((memory*)m)->lmscr);
+  free(((memory*)m)->lgscr);
+  free(((memory*)m)->lpscr);
+  free(((memory*)m)->a);
+  free(((memory*)m)->b);
 }
 
 /*
@@ -751,3 +1493,39 @@ void init(void** m) {
 size_t getMemorySize() {
   return sizeof(memory);
 }
+
+/*
+ * Función getMontSize
+ *
+ * Devuelve el tamaño del contexto de Montgomery.
+ */
+size_t getMontSize() {
+  return sizeof(BLmont);
+}
+
+/*
+ * Función getBarrettSize
+ *
+ * Devuelve el tamaño del contexto de Barrett.
+ */
+size_t getBarrettSize() {
+  return sizeof(BLbarrett);
+}
+
+/*
+ * Función getAccSize
+ *
+ * Devuelve el tamaño de un acumulador.
+ */
+size_t getAccSize() {
+  return sizeof(BLacc);
+}
+
+/*
+ * Función getBITSize
+ *
+ * Devuelve el tamaño de un BIT.
+ */
+size_t getBITSize() {
+  return sizeof(BIT);
+}
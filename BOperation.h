@@ -19,51 +19,58 @@ typedef struct memory {
   void* stmp;
 
   //mul
-  void* mpart;
-  void* mret;
-  void* mzero;
-  void* mone;
-  void* mtmp;
+  int threads;
 
   //dvs
-  void* done;
-  void* dtmp;
-  void* dret;
+  int point;
   void* dTemp;
-  void* biTemp;
 
   //nqrt
-  void* sret;
-  void* sraw;
-  void* sbase;
-  void* szero;
+  void* lsscr;
 
   //bipow
   void* bres;
   void* btmp;
 
-  //append
-  void* aaux;
-
-  //BIT
-  void* biBIT;
+  //limb engine
+  void* la;
+  void* lb;
+  void* lr;
+  void* lscr;
+  void* ld;
+  void* ldscr;
+  void* lmscr;
+  void* lgscr;
+  void* lpscr;
 
   //cal2op
   void* a;
   void* b;
 } memory;
 
+/*
+ * operation: una operación de operate
+ *
+ * op: 'a' add, 's' sub, 'm' mul, 'd' dvs, 'e' equals (resultado en ret),
+ *     'b' bmod(va, vc), 'x' modmul(va, vb, vc), 'q' modsqr(va, vc), 'p' modpow(va, vb, vc)
+ * m: no se usa en operate (cada hilo tiene su memory)
+ * status: código de error de la operación (0 = OK), lo rellena operate
+ */
 typedef struct operation {
   void* va;
   void* vb;
+  void* vc;
   void* m;
   int* ret;
+  int status;
   char op;
 } operation;
 
 //Generales
 void showError(int k);
 void toString(void *vb, char* dst);
+int toStringN(void* vb, char* dst, int size);
+int getStrLen(void* va);
 void clean(void *va);
 void iniStr(char** dst);
 static char getKind(void* a);
@@ -71,6 +78,10 @@ static void adjustData(void* va, int offset, int up);
 void equals(void* va, void* vb, void* m, int* ret);
 void init(void** m);
 size_t getMemorySize();
+size_t getMontSize();
+size_t getBarrettSize();
+size_t getAccSize();
+size_t getBITSize();
 static void rePos(void* va);
 static void decimalize(void* va);
   
@@ -85,15 +96,50 @@ void mul(void *va, void *vb, void* m);
   
 //División
 void dvs(void *va, void *vb, void* m);
+
+//División con resto
+void divmod(void* vq, void* vr, void* va, void* vb, void* m);
   
+//Aritmética modular
+void barrettInit(void* vc, void* vn, void* m);
+void bmod(void* va, void* vc, void* m);
+void montInit(void* vc, void* vn, void* m);
+void modmul(void* va, void* vb, void* vc, void* m);
+void modsqr(void* va, void* vc, void* m);
+void modpow(void* va, void* ve, void* vc, void* m);
+
+//Máximo común divisor e inverso modular
+void gcd(void* va, void* vb, void* m);
+void xgcd(void* vg, void* vx, void* vy, void* va, void* vb, void* m);
+void modinv(void* va, void* vn, void* m);
+
+//Operando fijo (BIT)
+void bitInit(void* vt, void* vb, void* m);
+void bitMul(void* va, void* vb, void* vt, void* m);
+void bitDvs(void* va, void* vb, void* vt, void* m);
+void bitDivmod(void* vq, void* vr, void* va, void* vb, void* vt, void* m);
+
+//Acumuladores
+void accInit(void* vc);
+void accAdd(void* vc, void* va, void* m);
+void accSub(void* vc, void* va, void* m);
+void accMul(void* vc, void* va, void* vb, void* m);
+void accDot(void* vc, void* va, void* vb, int n, void* m);
+void accGet(void* va, void* vc, void* m);
+
+//Primalidad
+int isProbablePrime(void* va, int rounds, void* m);
+int primeSieve(void* va, int len, char* res, int rounds, void* m);
+
 //Raíz Cuadrada
 void nqrt(void* va, int n, void* m);
   
 //Potencia
 void bipow(void *va, int p, void* m);
+void bipowBI(void* va, void* ve, void* m);
 
 //Operación por lotes
-//void operate(int count, ...);
+int operate(operation* ops, int count, int threads);
 
 //Utilidades
 void biSig(void* va);
@@ -103,5 +149,9 @@ void BI2BD(void* dst, void* src);
 static void cal2op(void* va, void* vb, void* m, char k, int* ret);
 static void dummyOp1(void* da, void* db, void* m);
 static void dummyOp2(void* da, void* db, int* di);
+static void runOp(operation* o, void* m);
+static int takeOp(void* vq);
+static int stealOp(void* vw);
+static void freeMemory(void* m);
 
 #endif /* BOPERATION_H_ */
@@ -0,0 +1,631 @@
+/*
+ * BigBatch.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Batches of numbers on structure of arrays layout (limb i of every number is contiguous), to
+ *  add, subtract and compare many independent pairs at once. Limbs are the ones of BigLimb (base
+ *  10^9, that fit on 32 bits lanes), and numbers are kept on 10^9 complement on a fixed width, so
+ *  the same lane-wise add with carry (or sub with borrow) works for any sign.
+ *
+ *  Kernels are given as scalar code, AVX2 (8 numbers per instruction) and AVX-512 (16 numbers).
+ *  The widest one the CPU has is chosen once, on the first call (lCpu), unless BBsetSimd (or
+ *  C_BB_SIMD) asks for a smaller one. The vector kernels are compiled with target attributes, so no -mavx2
+ *  flag is needed and the binary still runs on CPUs without them.
+ *
+ *  CHANGELOG
+ *  v1.0
+ *    - Batches (BBinit, BBfree) and moves from/to BigInteger (BBset, BBget).
+ *    - Lane-wise add, sub and compare (BBadd, BBsub, BBequals), with CPUID dispatch (BBsetSimd).
+ *  v1.1
+ *    - The default level is chosen with pthread_once (InitOnceExecuteOnce on Windows), so threads
+ *      that make their first call at the same time don't race on it.
+ */
+#include "stdlib.h"
+#include "string.h"
+#include "BigInteger.h"
+#include "BigBatch.h"
+
+//one-time choice of the level
+#if defined(_WIN32)
+#include "windows.h"
+#define BB_ONCE_FN(f) BOOL CALLBACK f(PINIT_ONCE o, PVOID p, PVOID* c)
+#define BB_ONCE_END return TRUE
+#define BB_ONCE(o, f) InitOnceExecuteOnce(&(o), f, NULL, NULL)
+#define BB_ONCE_INIT INIT_ONCE_STATIC_INIT
+typedef INIT_ONCE BBonce;
+#else
+#include "pthread.h"
+#define BB_ONCE_FN(f) void f()
+#define BB_ONCE_END return
+#define BB_ONCE(o, f) pthread_once(&(o), f)
+#define BB_ONCE_INIT PTHREAD_ONCE_INIT
+typedef pthread_once_t BBonce;
+#endif
+
+//vector kernels on x86 (GCC, Clang and MSVC)
+#if (defined(__GNUC__) || defined(_MSC_VER)) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define BB_X86 1
+#include "immintrin.h"
+#if defined(_MSC_VER)
+#define BB_AVX2_FN
+#define BB_AVX512_FN
+#else
+#define BB_AVX2_FN __attribute__((target("avx2")))
+#define BB_AVX512_FN __attribute__((target("avx512f")))
+#endif
+#endif
+
+//BB_SIMD: widest level used by default
+#ifdef C_BB_SIMD
+#define BB_SIMD C_BB_SIMD
+#else
+#define BB_SIMD BB_AVX512
+#endif
+
+//BB_HALF: a number is negative when its upper limb is BB_HALF or more
+#define BB_HALF (BL_BASE / 2)
+
+//level in use (chosen once, see BBsimd)
+static int BBlevel = BB_SCALAR;
+static BBonce BBlevelOnce = BB_ONCE_INIT;
+
+//BBcpu
+static int BBcpu();
+
+//BBsimd
+static int BBsimd();
+
+/*
+ * BBcpu.
+ *
+ * Returns the widest level the CPU (and the OS) can run.
+ */
+static int BBcpu() {
+  int f = lCpu();
+
+  if ((f & BL_CPU_AVX512F) != 0)
+    return BB_AVX512;
+
+  if ((f & BL_CPU_AVX2) != 0)
+    return BB_AVX2;
+
+  return BB_SCALAR;
+}
+
+/*
+ * BBsetSimd.
+ *
+ * Sets the widest level to use (BB_SCALAR, BB_AVX2 or BB_AVX512), as long as the CPU has it.
+ * Returns the level that will be used. Call it before the threads that use batches start.
+ */
+int BBsetSimd(int max) {
+  int c = BBcpu();
+
+  //the default choice is made first, so it can't override this one later
+  BBsimd();
+
+  BBlevel = max < c ? max : c;
+
+  if (BBlevel < BB_SCALAR)
+    BBlevel = BB_SCALAR;
+
+  return BBlevel;
+}
+
+/*
+ * BBfirst.
+ *
+ * Chooses the default level (run once, by BBsimd).
+ */
+static BB_ONCE_FN(BBfirst) {
+  int c = BBcpu();
+
+  BBlevel = BB_SIMD < c ? BB_SIMD : c;
+
+  if (BBlevel < BB_SCALAR)
+    BBlevel = BB_SCALAR;
+
+  BB_ONCE_END;
+}
+
+/*
+ * BBsimd.
+ *
+ * Level in use. The default one is chosen on the first call from any thread, and the other ones
+ * wait for it, so there's no race on BBlevel.
+ */
+static int BBsimd() {
+  BB_ONCE(BBlevelOnce, BBfirst);
+
+  return BBlevel;
+}
+
+/*
+ * BBbits.
+ *
+ * Bits set on m.
+ */
+static int BBbits(unsigned int m) {
+  int ret = 0;
+
+  for (; m != 0; m &= m - 1)
+    ++ret;
+
+  return ret;
+}
+
+/*
+ * BBinit.
+ *
+ * Starts a batch of "count" numbers of up to "digits" digits (all of them 0). The width has
+ * room for the sign and for the carry of a sum. Returns 0 if everything went OK and 1 on wrong
+ * sizes or if there's no memory.
+ */
+int BBinit(BigBatch* b, int count, int digits) {
+  memset(b, 0, sizeof(BigBatch));
+
+  if (count < 1 || digits < 1)
+    return 1;
+
+  b->count = count;
+  b->stride = (count + BB_LANES - 1) / BB_LANES * BB_LANES;
+  b->limbs = digits / BL_DIGITS + 2;
+  b->l = (BLlimb*)calloc((size_t)b->limbs * b->stride, sizeof(BLlimb));
+
+  return b->l == NULL ? 1 : 0;
+}
+
+/*
+ * BBfree.
+ *
+ * Releases the limbs of a batch.
+ */
+void BBfree(BigBatch* b) {
+  free(b->l);
+  memset(b, 0, sizeof(BigBatch));
+}
+
+/*
+ * BBset.
+ *
+ * Moves the BigInteger va to number j of the batch. Returns 1 if j is out of the batch or if va
+ * doesn't fit on its width.
+ */
+int BBset(BigBatch* b, int j, void* va) {
+  BLlimb* c = b->l + j;
+  int top = ((BigInteger*)va)->count;
+  int n = top / BL_DIGITS + 1;
+  int neg = ((BigInteger*)va)->n[top] < 0;
+  BLlimb carry = 1;
+  BLlimb v;
+  int i;
+  int x;
+  int d;
+
+  if (j < 0 || j >= b->count || n > b->limbs - 1)
+    return 1;
+
+  for (i = 0; i < b->limbs; i++) {
+    v = 0;
+
+    //most significant digit of the group goes first
+    for (x = i * BL_DIGITS + BL_DIGITS - 1; x >= i * BL_DIGITS; x--) {
+      if (x <= top) {
+        d = ((BigInteger*)va)->n[x];
+        v = v * 10 + (BLlimb)(d < 0 ? -d : d);
+      }
+    }
+
+    //BL_BASE^limbs - |va| = (BL_BASE - 1 - limb) on every limb, plus 1
+    if (neg) {
+      v = BL_BASE - 1 - v + carry;
+      carry = v == BL_BASE;
+
+      if (carry)
+        v = 0;
+    }
+
+    c[i * b->stride] = v;
+  }
+
+  return 0;
+}
+
+/*
+ * BBget.
+ *
+ * Moves number j of the batch to the BigInteger dst. Returns 1 if j is out of the batch or if the
+ * number doesn't fit on MAX_LENGTH digits (dst is left on 0).
+ */
+int BBget(void* dst, BigBatch* b, int j) {
+  BLlimb* c = b->l + j;
+  BLlimb carry = 1;
+  BLlimb v;
+  int neg;
+  int top = 0;
+  int x = 0;
+  int i;
+  int d;
+
+  ((BigInteger*)dst)->k = 'i';
+  ((BigInteger*)dst)->count = 0;
+  memset(((BigInteger*)dst)->n, 0, MAX_LENGTH);
+
+  if (j < 0 || j >= b->count)
+    return 1;
+
+  neg = c[(b->limbs - 1) * b->stride] >= BB_HALF;
+
+  for (i = 0; i < b->limbs; i++) {
+    v = c[i * b->stride];
+
+    if (neg) {
+      v = BL_BASE - 1 - v + carry;
+      carry = v == BL_BASE;
+
+      if (carry)
+        v = 0;
+    }
+
+    for (d = 0; d < BL_DIGITS; d++, x++, v /= 10) {
+      if (v % 10 != 0) {
+        if (x >= MAX_LENGTH) {
+          memset(((BigInteger*)dst)->n, 0, MAX_LENGTH);
+
+          return 1;
+        }
+
+        ((BigInteger*)dst)->n[x] = (signed char)(v % 10);
+        top = x;
+      }
+    }
+  }
+
+  ((BigInteger*)dst)->count = top;
+
+  if (neg)
+    ((BigInteger*)dst)->n[top] *= -1;
+
+  return 0;
+}
+
+/*
+ * BBaddSubScalar.
+ *
+ * Performs a += b (a -= b if sub is 1) on numbers [lo, hi). Returns the numbers that went out
+ * of the width (the sign of the result is wrong).
+ */
+static int BBaddSubScalar(BLlimb* a, BLlimb* b, int lo, int hi, int stride, int limbs, int sub) {
+  int top = (limbs - 1) * stride;
+  int ret = 0;
+  int sa;
+  int sb;
+  int i;
+  BLlimb c;
+  BLlimb s;
+
+  for (; lo < hi; lo++) {
+    sa = a[top + lo] >= BB_HALF;
+    sb = b[top + lo] >= BB_HALF;
+    c = 0;
+
+    for (i = lo; i <= top + lo; i += stride) {
+      if (sub) {
+        s = a[i] + BL_BASE - b[i] - c;
+        c = s < BL_BASE;
+
+        if (c == 0)
+          s -= BL_BASE;
+      } else {
+        s = a[i] + b[i] + c;
+        c = s >= BL_BASE;
+
+        if (c == 1)
+          s -= BL_BASE;
+      }
+
+      a[i] = s;
+    }
+
+    //a + b overflows if a and b share sign and the result doesn't; a - b if they don't
+    if ((sa == sb) != sub && (a[top + lo] >= BB_HALF) != sa)
+      ++ret;
+  }
+
+  return ret;
+}
+
+/*
+ * BBequalsScalar.
+ *
+ * Compares numbers [lo, hi): ret[j] is 0 if a = b, 1 if a > b and 2 if a < b.
+ */
+static void BBequalsScalar(BLlimb* a, BLlimb* b, int lo, int hi, int stride, int limbs, int* ret) {
+  int top = (limbs - 1) * stride;
+  BLlimb ka;
+  BLlimb kb;
+  int i;
+
+  for (; lo < hi; lo++) {
+    //upper limbs are biased by BB_HALF, so negative numbers go below the positive ones
+    ka = (a[top + lo] + BB_HALF) % BL_BASE;
+    kb = (b[top + lo] + BB_HALF) % BL_BASE;
+
+    for (i = top + lo - stride; ka == kb && i >= lo; i -= stride) {
+      ka = a[i];
+      kb = b[i];
+    }
+
+    ret[lo] = ka == kb ? 0 : (ka > kb ? 1 : 2);
+  }
+}
+
+#if BB_X86 == 1
+/*
+ * BBaddSubAvx2.
+ *
+ * AVX2 version of BBaddSubScalar, over the whole stride (8 numbers per vector). Lanes hold
+ * limbs below BL_BASE, so sums and differences fit on signed 32 bits.
+ */
+BB_AVX2_FN static int BBaddSubAvx2(BLlimb* a, BLlimb* b, int stride, int limbs, int sub) {
+  const __m256i base = _mm256_set1_epi32((int)BL_BASE);
+  const __m256i max = _mm256_set1_epi32((int)BL_BASE - 1);
+  const __m256i half = _mm256_set1_epi32((int)BB_HALF - 1);
+  const __m256i zero = _mm256_setzero_si256();
+  int top = (limbs - 1) * stride;
+  int ret = 0;
+  int j = 0;
+  int i;
+  __m256i sa;
+  __m256i sb;
+  __m256i sr;
+  __m256i c;
+  __m256i s;
+  __m256i m;
+
+  for (; j < stride; j += 8) {
+    sa = _mm256_cmpgt_epi32(_mm256_loadu_si256((__m256i*)(a + top + j)), half);
+    sb = _mm256_cmpgt_epi32(_mm256_loadu_si256((__m256i*)(b + top + j)), half);
+    c = zero;
+
+    for (i = j; i <= top + j; i += stride) {
+      if (sub) {
+        s = _mm256_sub_epi32(_mm256_sub_epi32(_mm256_loadu_si256((__m256i*)(a + i)), _mm256_loadu_si256((__m256i*)(b + i))), c);
+        m = _mm256_cmpgt_epi32(zero, s);
+        s = _mm256_add_epi32(s, _mm256_and_si256(m, base));
+      } else {
+        s = _mm256_add_epi32(_mm256_add_epi32(_mm256_loadu_si256((__m256i*)(a + i)), _mm256_loadu_si256((__m256i*)(b + i))), c);
+        m = _mm256_cmpgt_epi32(s, max);
+        s = _mm256_sub_epi32(s, _mm256_and_si256(m, base));
+      }
+
+      //the mask is -1 where there's carry (or borrow)
+      c = _mm256_srli_epi32(m, 31);
+      _mm256_storeu_si256((__m256i*)(a + i), s);
+    }
+
+    sr = _mm256_cmpgt_epi32(_mm256_loadu_si256((__m256i*)(a + top + j)), half);
+    m = _mm256_xor_si256(sa, sb);
+    m = sub ? _mm256_and_si256(m, _mm256_xor_si256(sa, sr)) : _mm256_andnot_si256(m, _mm256_xor_si256(sa, sr));
+    ret += BBbits((unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+  }
+
+  return ret;
+}
+
+/*
+ * BBequalsAvx2.
+ *
+ * AVX2 version of BBequalsScalar, over the whole stride. Lanes above count go to "pad".
+ */
+BB_AVX2_FN static void BBequalsAvx2(BLlimb* a, BLlimb* b, int count, int stride, int limbs, int* ret) {
+  const __m256i base = _mm256_set1_epi32((int)BL_BASE);
+  const __m256i max = _mm256_set1_epi32((int)BL_BASE - 1);
+  const __m256i half = _mm256_set1_epi32((int)BB_HALF);
+  const __m256i one = _mm256_set1_epi32(1);
+  int top = (limbs - 1) * stride;
+  int pad[8];
+  int j = 0;
+  int i;
+  __m256i ka;
+  __m256i kb;
+  __m256i gt;
+  __m256i lt;
+  __m256i eq;
+
+  for (; j < stride; j += 8) {
+    ka = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(a + top + j)), half);
+    ka = _mm256_sub_epi32(ka, _mm256_and_si256(_mm256_cmpgt_epi32(ka, max), base));
+    kb = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(b + top + j)), half);
+    kb = _mm256_sub_epi32(kb, _mm256_and_si256(_mm256_cmpgt_epi32(kb, max), base));
+    gt = _mm256_cmpgt_epi32(ka, kb);
+    lt = _mm256_cmpgt_epi32(kb, ka);
+    eq = _mm256_cmpeq_epi32(ka, kb);
+
+    //only the lanes still equal look at the next limb
+    for (i = top + j - stride; i >= j && _mm256_testz_si256(eq, eq) == 0; i -= stride) {
+      ka = _mm256_loadu_si256((__m256i*)(a + i));
+      kb = _mm256_loadu_si256((__m256i*)(b + i));
+      gt = _mm256_or_si256(gt, _mm256_and_si256(eq, _mm256_cmpgt_epi32(ka, kb)));
+      lt = _mm256_or_si256(lt, _mm256_and_si256(eq, _mm256_cmpgt_epi32(kb, ka)));
+      eq = _mm256_and_si256(eq, _mm256_cmpeq_epi32(ka, kb));
+    }
+
+    //1 where a > b, 2 where a < b
+    gt = _mm256_or_si256(_mm256_and_si256(gt, one), _mm256_and_si256(lt, _mm256_add_epi32(one, one)));
+
+    if (j + 8 <= count)
+      _mm256_storeu_si256((__m256i*)(ret + j), gt);
+    else {
+      _mm256_storeu_si256((__m256i*)pad, gt);
+
+      for (i = j; i < count; i++)
+        ret[i] = pad[i - j];
+    }
+  }
+}
+
+/*
+ * BBaddSubAvx512.
+ *
+ * AVX-512 version of BBaddSubScalar, over the whole stride (16 numbers per vector).
+ */
+BB_AVX512_FN static int BBaddSubAvx512(BLlimb* a, BLlimb* b, int stride, int limbs, int sub) {
+  const __m512i base = _mm512_set1_epi32((int)BL_BASE);
+  const __m512i max = _mm512_set1_epi32((int)BL_BASE - 1);
+  const __m512i half = _mm512_set1_epi32((int)BB_HALF - 1);
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i one = _mm512_set1_epi32(1);
+  int top = (limbs - 1) * stride;
+  int ret = 0;
+  int j = 0;
+  int i;
+  __mmask16 sa;
+  __mmask16 sb;
+  __mmask16 sr;
+  __mmask16 m;
+  __m512i c;
+  __m512i s;
+
+  for (; j < stride; j += 16) {
+    sa = _mm512_cmpgt_epi32_mask(_mm512_loadu_si512(a + top + j), half);
+    sb = _mm512_cmpgt_epi32_mask(_mm512_loadu_si512(b + top + j), half);
+    c = zero;
+
+    for (i = j; i <= top + j; i += stride) {
+      if (sub) {
+        s = _mm512_sub_epi32(_mm512_sub_epi32(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)), c);
+        m = _mm512_cmpgt_epi32_mask(zero, s);
+        s = _mm512_mask_add_epi32(s, m, s, base);
+      } else {
+        s = _mm512_add_epi32(_mm512_add_epi32(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)), c);
+        m = _mm512_cmpgt_epi32_mask(s, max);
+        s = _mm512_mask_sub_epi32(s, m, s, base);
+      }
+
+      c = _mm512_maskz_mov_epi32(m, one);
+      _mm512_storeu_si512(a + i, s);
+    }
+
+    sr = _mm512_cmpgt_epi32_mask(_mm512_loadu_si512(a + top + j), half);
+    m = (__mmask16)(sub ? (sa ^ sb) & (sa ^ sr) : ~(sa ^ sb) & (sa ^ sr));
+    ret += BBbits((unsigned int)m);
+  }
+
+  return ret;
+}
+
+/*
+ * BBequalsAvx512.
+ *
+ * AVX-512 version of BBequalsScalar, over the whole stride.
+ */
+BB_AVX512_FN static void BBequalsAvx512(BLlimb* a, BLlimb* b, int count, int stride, int limbs, int* ret) {
+  const __m512i base = _mm512_set1_epi32((int)BL_BASE);
+  const __m512i max = _mm512_set1_epi32((int)BL_BASE - 1);
+  const __m512i half = _mm512_set1_epi32((int)BB_HALF);
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i two = _mm512_set1_epi32(2);
+  int top = (limbs - 1) * stride;
+  int j = 0;
+  int i;
+  __mmask16 gt;
+  __mmask16 lt;
+  __mmask16 eq;
+  __m512i ka;
+  __m512i kb;
+
+  for (; j < stride; j += 16) {
+    ka = _mm512_add_epi32(_mm512_loadu_si512(a + top + j), half);
+    ka = _mm512_mask_sub_epi32(ka, _mm512_cmpgt_epi32_mask(ka, max), ka, base);
+    kb = _mm512_add_epi32(_mm512_loadu_si512(b + top + j), half);
+    kb = _mm512_mask_sub_epi32(kb, _mm512_cmpgt_epi32_mask(kb, max), kb, base);
+    gt = _mm512_cmpgt_epi32_mask(ka, kb);
+    lt = _mm512_cmpgt_epi32_mask(kb, ka);
+    eq = _mm512_cmpeq_epi32_mask(ka, kb);
+
+    for (i = top + j - stride; i >= j && eq != 0; i -= stride) {
+      ka = _mm512_loadu_si512(a + i);
+      kb = _mm512_loadu_si512(b + i);
+      gt |= _mm512_mask_cmpgt_epi32_mask(eq, ka, kb);
+      lt |= _mm512_mask_cmpgt_epi32_mask(eq, kb, ka);
+      eq = _mm512_mask_cmpeq_epi32_mask(eq, ka, kb);
+    }
+
+    //lanes above count are not stored
+    ka = _mm512_mask_mov_epi32(_mm512_maskz_mov_epi32(gt, one), lt, two);
+    _mm512_mask_storeu_epi32(ret + j, (__mmask16)(j + 16 <= count ? 0xffff : (1u << (count - j)) - 1), ka);
+  }
+}
+#endif
+
+/*
+ * BBadd.
+ *
+ * Performs a += b on every number. a and b shall have the same count and digits. Returns -1 if
+ * they don't, or else the numbers that went out of the width (they keep the result modulo
+ * BL_BASE^limbs).
+ */
+int BBadd(BigBatch* a, BigBatch* b) {
+  if (a->count != b->count || a->limbs != b->limbs)
+    return -1;
+
+#if BB_X86 == 1
+  if (BBsimd() == BB_AVX512)
+    return BBaddSubAvx512(a->l, b->l, a->stride, a->limbs, 0);
+
+  if (BBsimd() == BB_AVX2)
+    return BBaddSubAvx2(a->l, b->l, a->stride, a->limbs, 0);
+#endif
+
+  return BBaddSubScalar(a->l, b->l, 0, a->count, a->stride, a->limbs, 0);
+}
+
+/*
+ * BBsub.
+ *
+ * Performs a -= b on every number. Returns as BBadd.
+ */
+int BBsub(BigBatch* a, BigBatch* b) {
+  if (a->count != b->count || a->limbs != b->limbs)
+    return -1;
+
+#if BB_X86 == 1
+  if (BBsimd() == BB_AVX512)
+    return BBaddSubAvx512(a->l, b->l, a->stride, a->limbs, 1);
+
+  if (BBsimd() == BB_AVX2)
+    return BBaddSubAvx2(a->l, b->l, a->stride, a->limbs, 1);
+#endif
+
+  return BBaddSubScalar(a->l, b->l, 0, a->count, a->stride, a->limbs, 1);
+}
+
+/*
+ * BBequals.
+ *
+ * Compares every number: ret[j] (count items) is 0 if a = b, 1 if a > b and 2 if a < b, as on
+ * equals. Returns 0 if everything went OK and -1 if a and b don't have the same shape.
+ */
+int BBequals(BigBatch* a, BigBatch* b, int* ret) {
+  if (a->count != b->count || a->limbs != b->limbs)
+    return -1;
+
+#if BB_X86 == 1
+  if (BBsimd() == BB_AVX512) {
+    BBequalsAvx512(a->l, b->l, a->count, a->stride, a->limbs, ret);
+    return 0;
+  }
+
+  if (BBsimd() == BB_AVX2) {
+    BBequalsAvx2(a->l, b->l, a->count, a->stride, a->limbs, ret);
+    return 0;
+  }
+#endif
+
+  BBequalsScalar(a->l, b->l, 0, a->count, a->stride, a->limbs, ret);
+
+  return 0;
+}
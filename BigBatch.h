@@ -0,0 +1,61 @@
+/*
+ * BigBatch.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ */
+#ifndef BIGBATCH_H_
+#define BIGBATCH_H_
+
+#include "BigLimb.h"
+
+//BB_LANES: numbers on the widest vector (AVX-512, 16 limbs). Columns are padded up to it
+#define BB_LANES 16
+
+//SIMD levels (see BBsetSimd)
+#define BB_SCALAR 0
+#define BB_AVX2 1
+#define BB_AVX512 2
+
+/*****************************************************************************
+ *                                 Structures                                *
+ *****************************************************************************/
+//Batch of "count" numbers, stored as structure of arrays: limb i of number j is on
+//l[i * stride + j], so a vector holds the same limb of many numbers. Every number takes "limbs"
+//limbs on 10^9 complement (a negative x is kept as BL_BASE^limbs - |x|), so add and sub don't
+//look at the sign. "stride" is count rounded up to BB_LANES (the padding is kept on 0)
+typedef struct BigBatch {
+  BLlimb* l;
+  int count;
+  int stride;
+  int limbs;
+} BigBatch;
+
+/*****************************************************************************
+ *                            Function definition                            *
+ *****************************************************************************/
+//BBinit
+int BBinit(BigBatch* b, int count, int digits);
+
+//BBfree
+void BBfree(BigBatch* b);
+
+//BBset
+int BBset(BigBatch* b, int j, void* va);
+
+//BBget
+int BBget(void* dst, BigBatch* b, int j);
+
+//BBadd
+int BBadd(BigBatch* a, BigBatch* b);
+
+//BBsub
+int BBsub(BigBatch* a, BigBatch* b);
+
+//BBequals
+int BBequals(BigBatch* a, BigBatch* b, int* ret);
+
+//BBsetSimd
+int BBsetSimd(int max);
+
+#endif /* BIGBATCH_H_ */
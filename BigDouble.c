@@ -20,97 +20,15 @@
  *      - Cambiado parámetro de precompilador de D_MAX_LENGTH
  *      - Añadido "signed" a n
  *      - Añadido return tras showError
+ *    v1.2
+ *      - Los valores útiles (_DZERO...) se crean al compilar: se elimina _BD_initialize y dini.
  */
 #include "stdio.h"
 #include "stdlib.h"
 #include "string.h"
 #include "BigDouble.h"
 
-float version = 1.1f;
-
-/*
- * Función initialize
- *
- * Da valores a ciertos datos útiles.
- */
-void _BD_initialize(int value) {
-  int i = 0;
-
-  if (value == 0) {
-    if (dini[0] == 0) {
-      //lo creamos manualmente ya que clean copia de _ZERO
-      for (; i < D_MAX_LENGTH; i++)
-        _DZERO.n[i] = 0;
-
-      _DZERO.count = 0;
-      _DZERO.cpos = 0;
-      _DZERO.k = 'd';
-      _DZERO.sig = 0;
-    }
-
-    dini[0] = 1;
-  } else if (value == 1) {
-    if (dini[1] == 0)
-      newBD(&_DONE, "1", 0);
-
-    dini[1] = 1;
-  } else if (value == 2) {
-    if (dini[2] == 0)
-      newBD(&_DTWO, "2", 0);
-
-    dini[2] = 1;
-  } else if (value == 3) {
-    if (dini[3] == 0)
-      newBD(&_DTHREE, "3", 0);
-
-    dini[3] = 1;
-  } else if (value == 4) {
-    if (dini[4] == 0)
-      newBD(&_DFOUR, "4", 0);
-
-    dini[4] = 1;
-  } else if (value == 5) {
-    if (dini[5] == 0)
-      newBD(&_DFIVE, "5", 0);
-
-    dini[5] = 1;
-  } else if (value == 6) {
-    if (dini[6] == 0)
-      newBD(&_DSIX, "6", 0);
-
-    dini[6] = 1;
-  } else if (value == 7) {
-    if (dini[7] == 0)
-      newBD(&_DSEVEN, "7", 0);
-
-    dini[7] = 1;
-  } else if (value == 8) {
-    if (dini[8] == 0)
-      newBD(&_DEIGHT, "8", 0);
-
-    dini[8] = 1;
-  } else if (value == 9) {
-    if (dini[9] == 0)
-      newBD(&_DNINE, "9", 0);
-
-    dini[9] = 1;
-  } else if (value == 10) {
-    if (dini[10] == 0)
-      newBD(&_DTEN, "10", 0);
-
-    dini[10] = 1;
-  } else if (value == 100) {
-    if (dini[11] == 0)
-      newBD(&_DHUND, "100", 0);
-
-    dini[11] = 1;
-  } else if (value == -1) {
-    if (dini[12] == 0)
-      newBD(&_DMIN, "1", -1);
-
-    dini[12] = 1;
-  }
-}
+float version = 1.2f;
 
 /*
  * Función BDmemcpy
@@ -118,8 +36,6 @@ void _BD_initialize(int value) {
  * Copia en el puntero destino la variable útil deseada
  */
 void BDmemcpy(void* dst, int value) {
-  _BD_initialize(value);
-
   if (value == 0)
     memcpy(dst, &_DZERO, sizeof(BigDouble));
   else if (value == 1)
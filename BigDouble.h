@@ -26,21 +26,20 @@ typedef struct BigDouble {
 /*
  * Variables útiles
  */
-static struct BigDouble _DZERO;
-static struct BigDouble _DONE;
-static struct BigDouble _DTWO;
-static struct BigDouble _DTHREE;
-static struct BigDouble _DFOUR;
-static struct BigDouble _DFIVE;
-static struct BigDouble _DSIX;
-static struct BigDouble _DSEVEN;
-static struct BigDouble _DEIGHT;
-static struct BigDouble _DNINE;
-static struct BigDouble _DTEN;
-static struct BigDouble _DHUND;
-static struct BigDouble _DMIN;
-
-static int dini[13] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+//se crean al compilar y no se modifican nunca, así se pueden compartir entre hilos
+static const struct BigDouble _DZERO = { 'd', 0, { 0 }, 0, 0 };
+static const struct BigDouble _DONE = { 'd', 0, { 1 }, 0, 0 };
+static const struct BigDouble _DTWO = { 'd', 0, { 2 }, 0, 0 };
+static const struct BigDouble _DTHREE = { 'd', 0, { 3 }, 0, 0 };
+static const struct BigDouble _DFOUR = { 'd', 0, { 4 }, 0, 0 };
+static const struct BigDouble _DFIVE = { 'd', 0, { 5 }, 0, 0 };
+static const struct BigDouble _DSIX = { 'd', 0, { 6 }, 0, 0 };
+static const struct BigDouble _DSEVEN = { 'd', 0, { 7 }, 0, 0 };
+static const struct BigDouble _DEIGHT = { 'd', 0, { 8 }, 0, 0 };
+static const struct BigDouble _DNINE = { 'd', 0, { 9 }, 0, 0 };
+static const struct BigDouble _DTEN = { 'd', 1, { 0, 1 }, 0, 0 };
+static const struct BigDouble _DHUND = { 'd', 2, { 0, 0, 1 }, 0, 0 };
+static const struct BigDouble _DMIN = { 'd', 0, { -1 }, 0, -1 };
 
 //delimitador decimal
 static char coma = ',';
@@ -60,5 +59,4 @@ void newBD(void* dst, char* s, int sig);
 //otros
 void validateBD(void* a);
 void BDmemcpy(void* dst, int value);
-void _BD_initialize(int value);
 #endif /* BIGDOUBLE_H_ */
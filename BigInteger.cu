@@ -210,6 +210,89 @@
  *    - Removed "m" parameter for "equals" function
  *    - newBI function now has a "const" on chat to avoid compiling warnings
  *    - Changes on pSub to avoid stack loop issue during CUDA linking
+ *  v6.1
+ *    - New limb engine (BigLimb.c). Numbers are packed on base 10^9 limbs (9 digits per word).
+ *      - New functions "BI2BL" and "BL2BI" to move data between BigInteger and BigLimb.
+ *    - "sMul" now multiplies on limbs instead of building the partial products digit by digit.
+ *  v6.2
+ *    - Multiplication is now size-dispatched on the limb engine: schoolbook, Karatsuba and Toom-3.
+ *  v6.3
+ *    - NTT multiplication tier for operands beyond a few thousand digits (see bench/mulbench.c).
+ *  v6.4
+ *    - New "sSqr" function. Squaring is made on the limb engine with a single packed operand.
+ *    - "sMul" uses "sSqr" when both operands are the same (no more copy to "mtmp").
+ *  v6.5
+ *    - "divide" works on the limb engine (schoolbook or Newton reciprocal) instead of Bolzano.
+ *      - The remainder is always left on "dTemp", so "mod" works for a < b and b = 1 as well.
+ *      - Bugfix on BigDouble division: the last decimal digit was lost when the remainder reached 0.
+ *        "getPoint" gives the decimal digits of the quotient, so exact quotients (7 / 2) keep their
+ *        decimal point, and 0's on the left of the operands don't count on its length.
+ *  v6.6
+ *    - New function "divmod" that gets quotient and remainder with a single division.
+ *    - Division by 0 keeps returning 0 (the remainder is a).
+ *  v6.7
+ *    - Modular arithmetic on a Montgomery context: "montInit", "modmul", "modsqr" and "modpow".
+ *      - "modpow" keeps every intermediate below the modulus, so the exponent is a BigInteger.
+ *  v6.8
+ *    - Barrett context for repeated reductions by the same modulus: "barrettInit" and "bmod".
+ *  v6.9
+ *    - "sBipow" uses sliding windows (odd powers are kept on "btmp") instead of a 10 bits exponent.
+ *      - Bugfix: odd powers of negative numbers were positive.
+ *    - New function "bipowBI" to use a BigInteger as exponent.
+ *  v6.91
+ *    - "sNqrt" uses Newton's iteration on the limb engine (lRoot) instead of Bolzano.
+ *      - Roots of negative numbers: odd roots are negative, even roots give 0.
+ *  v6.92
+ *    - New functions "BIcopy" and "BIzero", that only move the digits in use (digits above
+ *      count are always 0). They replace whole BigInteger copies on the arithmetic routines.
+ *      - "lUnpack" only clears the digits left by the former value.
+ *      - "mzero", "mone", "dtmp" and "done" variables removed ("_ZERO" and "_ONE" are used).
+ *    - Bugfix on "pSub": a - b with a = b gave -b.
+ *  v6.93
+ *    - Reentrant engine: every thread can work with its own memory without locks.
+ *      - Useful values ("_ZERO"...) are built at compile time and are constant ("_BI_initialize" removed).
+ *      - The decimal point is kept on memory ("point"), so "getPoint" receives the memory.
+ *      - The status code ("BIReturnCode") is thread local.
+ *  v6.94
+ *    - Big multiplications (and squarings, so bipow too) can be split between threads ("setThreads",
+ *      "C_MUL_THREADS" for the default value). Only operands from MUL_THREAD_THRESHOLD limbs are split.
+ *  v6.95
+ *    - New functions "gcd", "xgcd" and "modinv" on the limb engine (Lehmer and binary GCD). They work
+ *      over the "lgscr" buffer of memory, so nothing is allocated per call.
+ *  v6.96
+ *    - New functions "isProbablePrime" (trial division, Baillie-PSW and optional Miller-Rabin rounds
+ *      over the Montgomery path) and "primeSieve" (the same over a range, sieved first). They work
+ *      over the "lpscr" buffer of memory.
+ *  v6.97
+ *    - New functions "newBIN" (newBI over a buffer of known length, without '\0') and "toStringN"
+ *      (toString over a bounded buffer), and "getStrLen" to know the characters of a number.
+ *    - Bugfix on "newBI": strings of MAX_LENGTH + 1 and MAX_LENGTH + 2 digits went over the array,
+ *      and a "-" in the middle of the digits was taken as the sign.
+ *    - Bugfix on "iniStr": there was no room for the sign and '\0' of a MAX_LENGTH digits number.
+ *  v6.98
+ *    - Host backend for the CU* kernels ("CUDA_ENABLED" set to 2): no GPU is needed, and the same
+ *      kernels are launched on host threads with "CUlaunch" (or "CU_LAUNCH", that is a <<< >>> launch
+ *      on CUDA). "C_CU_THREADS" sets the threads (one per CPU by default).
+ *      - "h2d" and "d2h" copy on host memory, and new function "dFree" releases what h2d gave.
+ *    - Bugfix on "CUsqrt": remainders with leading 0's gave wrong digits (sqrt(100) was 14).
+ *    - Bugfix on "CUclean": only the first 1024 digits were cleaned.
+ *  v6.99
+ *    - Bugfix on "hardEquals" (and "CUhardEquals"): two negative numbers with the same length were
+ *      compared the wrong way (equals(-5, -4) was 1), so sub gave wrong results too.
+ *  v7.0
+ *    - "addition" and "subtract" work over the vector digit kernels of the limb engine (lDigitAdd and
+ *      lDigitSub: SSE2, AVX2 or AVX-512BW, chosen once through CPUID; "C_BL_SIMD" limits them).
+ *      Carries are resolved by blocks, so every digit is normalized once.
+ *    - Bugfix: a carry on a MAX_LENGTH digits sum was written out of the array.
+ *  v7.1
+ *    - Accumulators (getAccSize() bytes) to add many numbers or products with a single carry
+ *      propagation: "accInit", "accAdd", "accSub", "accMul", "accDot" and "accGet". Sums are kept
+ *      on 32-bit digit lanes and products on 64-bit limb lanes (BLacc), so there's room to defer.
+ *  v7.2
+ *    - "BIT" is now an operand pinned for multiplication and division ("bitInit", getBITSize() bytes):
+ *      it keeps the limbs of b and its divisor context (normalized divisor and reciprocal), that
+ *      "bitMul", "bitDvs" and "bitDivmod" reuse. If b changes, the BIT is built again.
+ *      - "biBIT" removed from memory (the former BIT buffer was not used since v6.1).
  */
 
 #include "string.h"
@@ -227,7 +310,46 @@
 #include "device_launch_parameters.h"
 #endif
 
-static float BI_VERSION = 6.0f;
+//host threads of the CU* kernels
+#if CUDA_ENABLED == 2
+#if defined(_WIN32)
+#include "windows.h"
+#define CU_THREAD_FN DWORD WINAPI
+#define CU_THREAD_START(t, f, a) (((t) = CreateThread(NULL, 0, f, a, 0, NULL)) == NULL)
+#define CU_THREAD_JOIN(t) (WaitForSingleObject(t, INFINITE), CloseHandle(t))
+typedef HANDLE CUthread;
+#else
+#include "unistd.h"
+#include "pthread.h"
+#define CU_THREAD_FN void*
+#define CU_THREAD_START(t, f, a) pthread_create(&(t), NULL, f, a)
+#define CU_THREAD_JOIN(t) pthread_join(t, NULL)
+typedef pthread_t CUthread;
+#endif
+
+//CU_MAX_WORKERS: maximum host threads of a launch
+#define CU_MAX_WORKERS 64
+
+//work of a host thread: blocks [lo, hi) of the grid
+typedef struct CUworker {
+  CUthread th;
+  void (*k)(void*);
+  void* arg;
+  int lo;
+  int hi;
+  int threads;
+  int blocks;
+  int started;
+} CUworker;
+
+//indexes of the emulated thread that is running
+BI_TLS CUdim threadIdx;
+BI_TLS CUdim blockIdx;
+BI_TLS CUdim blockDim;
+BI_TLS CUdim gridDim;
+#endif
+
+static float BI_VERSION = 7.2f;
 
 #if BI_STANDALONE == 1
 static int validate =
@@ -238,12 +360,13 @@ CVALIDATE;
 #endif
 #endif
 
-#if CUDA_ENABLED == 1
+#if CUDA_ENABLED == 1 || CUDA_ENABLED == 2
 /*
  * h2d
  *
  * Copies host memory to device memory.
  * It assumes that both device and host are an array of quantity items.
+ * On the host backend (CUDA_ENABLED 2) "device" is a copy on host memory.
  */
 void h2d(void** device, void* host, int quantity, size_t size) {
   if (quantity <= 0) {
@@ -252,8 +375,20 @@ void h2d(void** device, void* host, int quantity, size_t size) {
     return;
   }
 
+#if CUDA_ENABLED == 1
   cudaMalloc(device, size * quantity);
   cudaMemcpy(*device, host, size * quantity, cudaMemcpyHostToDevice);
+#else
+  *device = malloc(size * quantity);
+
+  if (*device == NULL) {
+    showError(52);
+
+    return;
+  }
+
+  memcpy(*device, host, size * quantity);
+#endif
 }
 
 /*
@@ -269,8 +404,122 @@ void d2h(void* host, void* device, int quantity, size_t size) {
     return;
   }
 
+#if CUDA_ENABLED == 1
   cudaMemcpy(host, device, size * quantity, cudaMemcpyDeviceToHost);
+#else
+  memcpy(host, device, size * quantity);
+#endif
+}
+
+/*
+ * dFree
+ *
+ * Releases the device memory given by h2d.
+ */
+void dFree(void* device) {
+#if CUDA_ENABLED == 1
+  cudaFree(device);
+#else
+  free(device);
+#endif
+}
+
+#if CUDA_ENABLED == 2
+/*
+ * CUrun.
+ *
+ * Runs the blocks of a host thread: every thread of every block is emulated one after another,
+ * with its own indexes. Kernels don't synchronize inside a block (__syncthreads), so the order
+ * doesn't matter.
+ */
+static CU_THREAD_FN CUrun(void* vw) {
+  CUworker* w = (CUworker*)vw;
+  int b = w->lo;
+  int t;
+
+  blockDim.x = w->threads;
+  blockDim.y = blockDim.z = 1;
+  gridDim.x = w->blocks;
+  gridDim.y = gridDim.z = 1;
+  blockIdx.y = blockIdx.z = 0;
+  threadIdx.y = threadIdx.z = 0;
+
+  for (; b < w->hi; b++) {
+    blockIdx.x = b;
+
+    for (t = 0; t < w->threads; t++) {
+      threadIdx.x = t;
+      w->k(w->arg);
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * CUlaunch.
+ *
+ * Host version of k<<<blocks, threads>>>(arg). The blocks are split between CU_THREADS host
+ * threads (one per CPU by default), being the caller one of them, and it returns when all of
+ * them are done. Returns 0 if everything went OK and 54 (after showError) on a wrong grid.
+ */
+int CUlaunch(void (*k)(void*), int blocks, int threads, void* arg) {
+  CUworker w[CU_MAX_WORKERS];
+  int n = CU_THREADS;
+  int i;
+
+  if (k == NULL || blocks <= 0 || threads <= 0) {
+    showError(54);
+
+    return 54;
+  }
+
+  if (n <= 0) {
+#if defined(_WIN32)
+    SYSTEM_INFO si;
+
+    GetSystemInfo(&si);
+    n = (int)si.dwNumberOfProcessors;
+#else
+    n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  }
+
+  if (n > CU_MAX_WORKERS)
+    n = CU_MAX_WORKERS;
+
+  if (n > blocks)
+    n = blocks;
+
+  if (n < 1)
+    n = 1;
+
+  for (i = 0; i < n; i++) {
+    w[i].k = k;
+    w[i].arg = arg;
+    w[i].lo = (int)((long long)blocks * i / n);
+    w[i].hi = (int)((long long)blocks * (i + 1) / n);
+    w[i].threads = threads;
+    w[i].blocks = blocks;
+    w[i].started = 0;
+  }
+
+  //w[0] goes on the caller, as the ones whose thread can't be started
+  for (i = 1; i < n; i++)
+    w[i].started = CU_THREAD_START(w[i].th, CUrun, w + i) == 0;
+
+  CUrun(w);
+
+  for (i = 1; i < n; i++) {
+    if (w[i].started)
+      CU_THREAD_JOIN(w[i].th);
+    else
+      CUrun(w + i);
+  }
+
+  return 0;
 }
+#endif
 
 /*
  * CUnewBI.
@@ -323,7 +572,7 @@ __device__ void CUnewBI(void* dst, char* s, int sig) {
 __device__ static void CUclean(void* va) {
   int i = 0;
 
-  for (i = 0; i < 1024; i++)
+  for (i = 0; i < (int)sizeof(((BigInteger*)va)->n); i++)
     ((BigInteger*)va)->n[i] = 0;
 
   ((BigInteger*)va)->count = 0;
@@ -691,6 +940,8 @@ __device__ void CUcarryAdd(void* va, int move, int min) {
 __device__ void CUhardEquals(void* va, void* vb, int* ret) {
   int i;
   int sig;
+  int x;
+  int y;
 
   //if pointer value is the same, they share value
   if (va == vb) {
@@ -719,11 +970,20 @@ __device__ void CUhardEquals(void* va, void* vb, int* ret) {
       //count(a) > count(b)
       *ret = 1;
     else {
-      //count(a) = count(b). Manual compare
+      //count(a) = count(b). Manual compare (on magnitude, as the upper digit keeps the sign)
       for (i = ((BigInteger*)va)->count; i >= 0; i--) {
-        if (((BigInteger*)va)->n[i] < ((BigInteger*)vb)->n[i])
+        x = ((BigInteger*)va)->n[i];
+        y = ((BigInteger*)vb)->n[i];
+
+        if (x < 0)
+          x = -x;
+
+        if (y < 0)
+          y = -y;
+
+        if (x < y)
           *ret = 2;
-        else if ((((BigInteger*)va)->n[i] > ((BigInteger*)vb)->n[i]))
+        else if (x > y)
           *ret = 1;
 
         if (*ret > 0)
@@ -999,9 +1259,8 @@ __device__ void CUsqrt(void* va, void* vb, void* vc, void* vd) {
   }
 
   //get the root of fstep
-  while (x * x++ <= fstep);
-  if (--x * x > fstep)
-    --x;
+  while ((x + 1) * (x + 1) <= fstep)
+    ++x;
 
   //"x" will be the first digit of the root
   ((BigInteger*)vb)->n[((BigInteger*)vb)->count] = x;
@@ -1039,8 +1298,9 @@ __device__ void CUsqrt(void* va, void* vb, void* vc, void* vd) {
     //set vc length up to two
     ((BigInteger*)vc)->count += 2;
 
-    //manage carry
+    //manage carry, and drop the leading 0's (the remainder may be 0)
     CUcarryAdd(vc, 0, 0);
+    CUrecount(vc);
 
     //copy current result (vb) to vd
     memcpy(vd, vb, sizeof(BigInteger));
@@ -1143,8 +1403,9 @@ __device__ void CUsqrt(void* va, void* vb, void* vc, void* vd) {
       for (y = 0; y <= ((BigInteger*)vd)->count; y++)
         ((BigInteger*)vd)->n[y] *= z;
 
-      //carry
+      //carry (z may be 0)
       CUcarryAdd(vd, 0, 0);
+      CUrecount(vd);
     }
 
     //move the digit
@@ -1197,8 +1458,18 @@ __device__ static int CUstrlen(char* s) {
  * If "sig" is -1, the number will be negative.
  */
 void newBI(void* dst, const char* s, int sig) {
-  int i = (int)strlen(s) - 1;
-  int f = i;
+  newBIN(dst, s, (int)strlen(s), sig);
+}
+
+/*
+ * newBIN.
+ *
+ * As newBI, but over the first "len" characters of s, that doesn't need to end with '\0'
+ * (so a number can be read straight from a bigger buffer). An optional "-" can lead the digits.
+ */
+void newBIN(void* dst, const char* s, int len, int sig) {
+  int i = len - 1;
+  int neg = len > 0 && s[0] == '-';
   int j = 0;
   int c;
   int ssig = sig;
@@ -1209,31 +1480,34 @@ void newBI(void* dst, const char* s, int sig) {
   //clean the array
   clean(dst);
 
-  if (i > MAX_LENGTH + 1) {
+  //every digit takes a position of n (the sign goes on the upper one)
+  if (len - neg > MAX_LENGTH) {
     showError(1);
     return;
   }
 
+  if (len - neg <= 0) {
+    showError(2);
+    return;
+  }
+
   //iterate over the string and save data as integers
-  for (; i >= 0; i--) {
+  for (; i >= neg; i--) {
     c = (int)(s[i] - 48);
 
     if (c >= 0 && c <= 9)
       ((BigInteger*)dst)->n[j++] = c;
-    else
-      if (s[i] == '-')
-        ssig = -1;
-      else {
-        showError(2);
-        return;
-      }
+    else {
+      clean(dst);
+      showError(2);
+      return;
+    }
   }
 
-  //if a negative is sent, remove a position
-  if (s[0] == '-')
-    --f;
+  if (neg == 1)
+    ssig = -1;
 
-  ((BigInteger*)dst)->count = f;
+  ((BigInteger*)dst)->count = j - 1;
 
   if (ssig == -1)
     ((BigInteger*)dst)->n[((BigInteger*)dst)->count] *= -1;
@@ -1271,10 +1545,20 @@ void validateBI(void* a) {
 /*
  * getPoint
  *
- * Returns the decimal point cut for the division
+ * Returns the decimal digits of the last BigDouble quotient made with m (0 for BigInteger).
+ * It's -1 if the division wasn't made (a / 1, a < b or b = 0) and -2 if a = b.
+ */
+int getPoint(void* m) {
+  return ((memory*)m)->point;
+}
+
+/*
+ * setThreads
+ *
+ * Sets the threads that multiplications made with m can use (1 = no threads)
  */
-int getPoint() {
-  return BI_point;
+void setThreads(void* m, int n) {
+  ((memory*)m)->threads = n < 1 ? 1 : n;
 }
 
 /*
@@ -1295,38 +1579,6 @@ void setReturnCode(int k) {
   BIReturnCode = k;
 }
 
-/*
- * _BI_initialize
- *
- * Give value to util data
- */
-#if BI_STANDALONE == 1 
-static
-#endif
-void _BI_initialize() {
-  int i = 0;
-
-  //we create it from scratch as "clean" copies from _ZERO
-  for (; i < MAX_LENGTH; i++)
-    _ZERO.n[i] = 0;
-
-  _ZERO.count = 0;
-  _ZERO.k = 'i';
-
-  newBI(&_ONE, "1", 0);
-  newBI(&_TWO, "2", 0);
-  newBI(&_THREE, "3", 0);
-  newBI(&_FOUR, "4", 0);
-  newBI(&_FIVE, "5", 0);
-  newBI(&_SIX, "6", 0);
-  newBI(&_SEVEN, "7", 0);
-  newBI(&_EIGHT, "8", 0);
-  newBI(&_NINE, "9", 0);
-  newBI(&_TEN, "10", 0);
-  newBI(&_HUND, "100", 0);
-  newBI(&_MIN, "1", -1);
-}
-
 /*
  * BImemcpy
  *
@@ -1364,18 +1616,177 @@ void BImemcpy(void* dst, int value) {
 }
 
 /*
- * pAppend.
+ * BIcopy
  *
- * Adds a digit at the end of the BigInteger
+ * Copies src into dst, moving only the digits in use. Digits above count are always 0, so
+ * dst only needs its own used digits cleared (its count is the high-water mark).
+ * dst shall hold a BigInteger; BImemcpy is used for unset data.
  */
-static void pAppend(void* va, int b) {
-  int i;
+#if BI_STANDALONE == 1
+static
+#endif
+void BIcopy(void* dst, void* src) {
+  int c = ((BigInteger*)dst)->count;
+  int n = ((BigInteger*)src)->count;
 
-  for (i = ((BigInteger*)va)->count; i >= 0; i--)
-    ((BigInteger*)va)->n[i + 1] = ((BigInteger*)va)->n[i];
+  if (dst == src)
+    return;
 
-  ((BigInteger*)va)->n[0] = b;
-  ++((BigInteger*)va)->count;
+  //count out of bounds: clear it all
+  if (c < 0 || c >= MAX_LENGTH)
+    c = MAX_LENGTH - 1;
+
+  memcpy(((BigInteger*)dst)->n, ((BigInteger*)src)->n, n + 1);
+
+  if (c > n)
+    memset(((BigInteger*)dst)->n + n + 1, 0, c - n);
+
+  ((BigInteger*)dst)->k = ((BigInteger*)src)->k;
+  ((BigInteger*)dst)->count = n;
+}
+
+/*
+ * BIzero
+ *
+ * Moves 0 into dst, clearing only the digits in use (as BIcopy does).
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+void BIzero(void* dst) {
+  int c = ((BigInteger*)dst)->count;
+
+  if (c < 0 || c >= MAX_LENGTH)
+    c = MAX_LENGTH - 1;
+
+  memset(((BigInteger*)dst)->n, 0, c + 1);
+
+  ((BigInteger*)dst)->k = 'i';
+  ((BigInteger*)dst)->count = 0;
+}
+
+/*
+ * BI2BL
+ *
+ * Converts a BigInteger into a BigLimb
+ */
+void BI2BL(void* dst, void* src) {
+  int n = lPack(((BigLimb*)dst)->n, src);
+
+  n = lLen(((BigLimb*)dst)->n, n);
+
+  ((BigLimb*)dst)->k = 'l';
+  ((BigLimb*)dst)->count = n > 0 ? n - 1 : 0;
+
+  if (((BigInteger*)src)->n[((BigInteger*)src)->count] < 0)
+    ((BigLimb*)dst)->sig = -1;
+  else
+    ((BigLimb*)dst)->sig = 0;
+}
+
+/*
+ * BL2BI
+ *
+ * Converts a BigLimb into a BigInteger
+ */
+void BL2BI(void* dst, void* src) {
+  ((BigInteger*)dst)->k = 'i';
+
+  if (lUnpack(dst, ((BigLimb*)src)->n, ((BigLimb*)src)->count + 1) == 1) {
+    showError(1);
+    return;
+  }
+
+  if (((BigLimb*)src)->sig == -1)
+    ((BigInteger*)dst)->n[((BigInteger*)dst)->count] *= -1;
+}
+
+/*
+ * lPack.
+ *
+ * Moves the absolute value of a BigInteger into limbs. Returns the number of limbs used.
+ */
+static int lPack(BLlimb* dst, void* va) {
+  return lPackShift(dst, va, 0);
+}
+
+/*
+ * lPackShift.
+ *
+ * Moves the absolute value of a BigInteger, multiplied by 10^s, into limbs. Returns the number of limbs used.
+ */
+static int lPackShift(BLlimb* dst, void* va, int s) {
+  int i = 0;
+  int j;
+  int n = 0;
+  int top = ((BigInteger*)va)->count + s;
+  BLlimb v;
+
+  for (; i <= top; i += BL_DIGITS) {
+    v = 0;
+
+    //most significant digit of the group goes first. The s lower digits are 0
+    for (j = i + BL_DIGITS - 1; j >= i; j--)
+      if (j <= top)
+        v = v * 10 + (j < s ? 0 : (((BigInteger*)va)->n[j - s] < 0 ? -((BigInteger*)va)->n[j - s] : ((BigInteger*)va)->n[j - s]));
+
+    dst[n++] = v;
+  }
+
+  return n;
+}
+
+/*
+ * lUnpack.
+ *
+ * Moves n limbs into a (positive) BigInteger. Returns 1 if the limit is reached.
+ */
+static int lUnpack(void* va, BLlimb* src, int n) {
+  int i = 0;
+  int x = 0;
+  int c = ((BigInteger*)va)->count;
+  BLlimb v;
+
+  n = lLen(src, n);
+
+  if (n == 0) {
+    BIzero(va);
+    return 0;
+  }
+
+  //digits of the most significant limb
+  for (v = src[n - 1]; v > 0; v /= 10)
+    ++x;
+
+  if ((n - 1) * BL_DIGITS + x > MAX_LENGTH)
+    return 1;
+
+  x = 0;
+
+  //full limbs
+  for (; i < n - 1; i++) {
+    v = src[i];
+
+    for (; x < (i + 1) * BL_DIGITS; x++) {
+      ((BigInteger*)va)->n[x] = (signed char)(v % 10);
+      v /= 10;
+    }
+  }
+
+  //most significant limb
+  for (v = src[n - 1]; v > 0; v /= 10)
+    ((BigInteger*)va)->n[x++] = (signed char)(v % 10);
+
+  ((BigInteger*)va)->count = x - 1;
+
+  //clear the digits left by the former value
+  if (c < 0 || c >= MAX_LENGTH)
+    c = MAX_LENGTH - 1;
+
+  if (c >= x)
+    memset(((BigInteger*)va)->n + x, 0, c - x + 1);
+
+  return 0;
 }
 
 /*
@@ -1413,6 +1824,8 @@ static
 void hardEquals(void* va, void* vb, int* ret) {
   int i;
   int sig;
+  int x;
+  int y;
 
   //if pointer value is the same, they share value
   if (va == vb) {
@@ -1441,11 +1854,20 @@ void hardEquals(void* va, void* vb, int* ret) {
       //count(a) > count(b)
       *ret = 1;
     else {
-      //count(a) = count(b). Manual compare
+      //count(a) = count(b). Manual compare (on magnitude, as the upper digit keeps the sign)
       for (i = ((BigInteger*)va)->count; i >= 0; i--) {
-        if (((BigInteger*)va)->n[i] < ((BigInteger*)vb)->n[i])
+        x = ((BigInteger*)va)->n[i];
+        y = ((BigInteger*)vb)->n[i];
+
+        if (x < 0)
+          x = -x;
+
+        if (y < 0)
+          y = -y;
+
+        if (x < y)
           *ret = 2;
-        else if ((((BigInteger*)va)->n[i] > ((BigInteger*)vb)->n[i]))
+        else if (x > y)
           *ret = 1;
 
         if (*ret > 0)
@@ -1528,6 +1950,7 @@ static void addition(void* va, void* vb) {
   int min;
   int swap;
   int move;
+  int c;
   int i;
 
   //assume "a" has the bigger lenght 
@@ -1538,7 +1961,6 @@ static void addition(void* va, void* vb) {
 
   //carry indicator 
   move = 0;
-  i = 0;
 
   //if the assumption is wrong, rectify
   if (((BigInteger*)vb)->count > limit) {
@@ -1550,80 +1972,32 @@ static void addition(void* va, void* vb) {
     move = 1;
   }
 
-  //add all the common digits
-  for (; i <= min; i++)
-    ((BigInteger*)va)->n[i] += ((BigInteger*)vb)->n[i];
+  //add all the common digits, carries included (vector kernel, see lDigitSimd)
+  c = lDigitAdd(((BigInteger*)va)->n, ((BigInteger*)vb)->n, min + 1);
 
   //move the even digits
   if (move == 1) {
-    for (; i <= limit; i++)
-      ((BigInteger*)va)->n[i] = ((BigInteger*)vb)->n[i];
+    memcpy(((BigInteger*)va)->n + min + 1, ((BigInteger*)vb)->n + min + 1, limit - min);
 
     ((BigInteger*)va)->count = limit;
   }
 
-  //carry management
-  carryAdd(va, 1, min);
-}
-
-/*
- * carryAdd.
- *
- * Manages addition carry.
- */
-#if BI_STANDALONE == 1
-static
-#endif
- void carryAdd(void* va, int move, int min) {
-  int i = 0;
-  int acc;
-  int limit;
-
-  acc = 0;
-
-  //move == 1 --> we know there's a non-common part. Min will be the common part threshold
-  if (move == 1)
-    limit = min;
-  else
-    limit = ((BigInteger*)va)->count;
-
-  //iterate and manage carry on the common part
-  for (; i <= limit; i++) {
-    //add carry
-    ((BigInteger*)va)->n[i] += acc;
-
-    //as acc is int, we can divide by 10 and get the carry
-    acc = ((BigInteger*)va)->n[i] / 10;
-
-    if (acc > 0)
-      //normalize the number
-      ((BigInteger*)va)->n[i] = ((BigInteger*)va)->n[i] % 10;
-  }
-
-  if (move == 1) {
-    //there's non-common part. Carry unitl acc = 0, as the non-common part is always normalized.
-    while (acc > 0 && i <= ((BigInteger*)va)->count) {
-      //add carry
-      ((BigInteger*)va)->n[i] += acc;
-
-      //as acc is int, we can divide by 10 and get the carry
-      acc = ((BigInteger*)va)->n[i] / 10;
-
-      if (acc > 0)
-        //normalize the number
-        ((BigInteger*)va)->n[i] = ((BigInteger*)va)->n[i] % 10;
+  //the carry goes through the 9's of the non-common part
+  for (i = min + 1; c == 1 && i <= limit; i++) {
+    c = ++((BigInteger*)va)->n[i] == 10;
 
-      i++;
-    }
+    if (c == 1)
+      ((BigInteger*)va)->n[i] = 0;
   }
 
   //if there's a carry left, we move it to the end
-  if (acc > 0) {
-    if (((BigInteger*)va)->count == MAX_LENGTH) {
+  if (c == 1) {
+    if (limit + 1 >= MAX_LENGTH) {
       showError(1);
       return;
-    } else
-      ((BigInteger*)va)->n[++(((BigInteger*)va)->count)] = acc;
+    }
+
+    ((BigInteger*)va)->n[++(((BigInteger*)va)->count)] = 1;
   }
 }
 
@@ -1648,7 +2022,7 @@ static
 
   if (va == vb) {
     //sub(a, a); result = 0
-    BImemcpy(va, 0);
+    BIzero(va);
   } else {
     //sub(a, b);
     hardEquals(va, vb, &comp);
@@ -1660,18 +2034,21 @@ static
     if ((comp == 2 && sig < 11) || (comp == 1 && sig == 11)) {
       sp = 1;
 
-      memcpy(((memory*)m)->stmp, vb, sizeof(BigInteger)); //stmp = b
+      BIcopy(((memory*)m)->stmp, vb); //stmp = b
 
       //switch va and vb
-      memcpy(vb, va, sizeof(BigInteger)); //vb = va
-      memcpy(va, ((memory*)m)->stmp, sizeof(BigInteger)); //va = tmp
+      BIcopy(vb, va); //vb = va
+      BIcopy(va, ((memory*)m)->stmp); //va = tmp
 
       //recalculate signum
       sig = signum(((BigInteger*)va)->n[((BigInteger*)va)->count],
         ((BigInteger*)vb)->n[((BigInteger*)vb)->count]);
-    } else if (comp == 0)
-      BImemcpy(va, 0);
-    
+    } else if (comp == 0) {
+      //a = b, result = 0 (subtracting b from it would leave -b)
+      BIzero(va);
+      return;
+    }
+
     //normalize sign
     if (sig == 1)
       ((BigInteger*)vb)->n[((BigInteger*)vb)->count] *= -1;
@@ -1704,7 +2081,7 @@ static
       ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
 
       //retrieve vb original value
-      memcpy(vb, ((memory*)m)->stmp, sizeof(BigInteger));
+      BIcopy(vb, ((memory*)m)->stmp);
     }
   }
 }
@@ -1715,17 +2092,32 @@ static
  * Performs a -= b
  */
 static void subtract(void* va, void* vb) {
+  int top = ((BigInteger*)va)->count;
   int i = 0;
+  int c;
 
-  //subtract common digits
-  for (; i <= ((BigInteger*)vb)->count; i++)
-    ((BigInteger*)va)->n[i] -= ((BigInteger*)vb)->n[i];
+  //|a| >= |b| (pSub makes sure), so the last digit is only negative if b has a bigger one there
+  if (((BigInteger*)vb)->count == top && ((BigInteger*)va)->n[top] < ((BigInteger*)vb)->n[top]) {
+    for (; i <= ((BigInteger*)vb)->count; i++)
+      ((BigInteger*)va)->n[i] -= ((BigInteger*)vb)->n[i];
 
-  //if last digit is negative
-  if (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0)
     carrySub(va, 1);
-  else
-    carrySub(va, 0);
+    return;
+  }
+
+  //subtract common digits, borrows included (vector kernel, see lDigitSimd)
+  c = lDigitSub(((BigInteger*)va)->n, ((BigInteger*)vb)->n, ((BigInteger*)vb)->count + 1);
+
+  //the borrow goes through the 0's of the rest
+  for (i = ((BigInteger*)vb)->count + 1; c == 1 && i <= top; i++) {
+    c = --((BigInteger*)va)->n[i] < 0;
+
+    if (c == 1)
+      ((BigInteger*)va)->n[i] = 9;
+  }
+
+  //count the digits again
+  recount(va);
 }
 
 /*
@@ -1785,40 +2177,32 @@ static
 #endif
  void sMul(void* va, void* vb, void* m) {
   int sig;
-  int i = 0;
-  int x;
+  int na;
+  int nb;
   int comp;
   int calc = 0;
 
-  if (((memory*)m)->biBIT == NULL || ((memory*)m)->mzero == NULL || ((memory*)m)->mone == NULL ||
-    ((memory*)m)->mpart == NULL || ((memory*)m)->mret == NULL || ((memory*)m)->mtmp == NULL) {
+  if (((memory*)m)->la == NULL || ((memory*)m)->lb == NULL || ((memory*)m)->lr == NULL || ((memory*)m)->lscr == NULL) {
     showError(3);
     return;
   }
 
   if (va == vb) {
     //mul(a, a)
-    //we copy it to tmp to work without collapsing the data
-    memcpy(((memory*)m)->mtmp, va, sizeof(BigInteger));
-
-    sMul(va, ((memory*)m)->mtmp, m);
+    sSqr(va, m);
   } else {
     //mul(a, b)
-    BImemcpy(((memory*)m)->mzero, 0);
-    BImemcpy(((memory*)m)->mret, 0);
-    BImemcpy(((memory*)m)->mone, 1);
-
     //if a = 0, no need to calculate
-    hardEquals(va, ((memory*)m)->mzero, &comp);
+    hardEquals(va, (void*)&_ZERO, &comp);
 
     if (comp == 0)
       calc = 1;
 
     //if a = 0, no need to calculate
-    hardEquals(vb, ((memory*)m)->mzero, &comp);
+    hardEquals(vb, (void*)&_ZERO, &comp);
 
     if (comp == 0) {
-      memcpy(va, ((memory*)m)->mzero, sizeof(BigInteger));
+      BIzero(va);
       calc = 1;
     }
 
@@ -1836,68 +2220,39 @@ static
     }
 
     //if |a| = 1, then a * b = b (sign will be later normalized)
-    hardEquals(va, ((memory*)m)->mone, &comp);
+    hardEquals(va, (void*)&_ONE, &comp);
 
     if (comp == 0) {
-      memcpy(va, vb, sizeof(BigInteger));
+      BIcopy(va, vb);
       calc = 1;
     }
 
     //if |b| = 1, then a * b = a (sign will be later normalized)
-    hardEquals(vb, ((memory*)m)->mone, &comp);
+    hardEquals(vb, (void*)&_ONE, &comp);
 
     if (comp == 0)
       calc = 1;
 
-    //initialize BIT
-    memcpy(&((BIT*)((memory*)m)->biBIT)->BI[0], ((memory*)m)->mzero, sizeof(BigInteger));
-    memcpy(&((BIT*)((memory*)m)->biBIT)->BI[1], va, sizeof(BigInteger));
-
-    ((BIT*)((memory*)m)->biBIT)->status[0] = 1;
-    ((BIT*)((memory*)m)->biBIT)->status[1] = 1;
-    ((BIT*)((memory*)m)->biBIT)->status[2] = 0;
-    ((BIT*)((memory*)m)->biBIT)->status[3] = 0;
-    ((BIT*)((memory*)m)->biBIT)->status[4] = 0;
-    ((BIT*)((memory*)m)->biBIT)->status[5] = 0;
-    ((BIT*)((memory*)m)->biBIT)->status[6] = 0;
-    ((BIT*)((memory*)m)->biBIT)->status[7] = 0;
-    ((BIT*)((memory*)m)->biBIT)->status[8] = 0;
-    ((BIT*)((memory*)m)->biBIT)->status[9] = 0;
-
-    //if the number is not calculated (a = 0, b = 0, |a| = 1, |b| = 1), we calculate it
+    //if the number is not calculated (a = 0, b = 0, |a| = 1, |b| = 1), we calculate it on the limb engine
     if (calc == 0) {
-      //perform partial product for each digit of b
-      for (i = 0; i <= ((BigInteger*)vb)->count; i++) {
-        //validate if BIT[n] exists
-        if (((BIT*)((memory*)m)->biBIT)->status[((BigInteger*)vb)->n[i]] == 0) {
-          clean(((memory*)m)->mpart);
-
-          //we don't have the BIT loaded, so we calculate it
-          for (x = 0; x <= ((BigInteger*)va)->count; x++)
-            ((BigInteger*)((memory*)m)->mpart)->n[x] = ((BigInteger*)va)->n[x] * ((BigInteger*)vb)->n[i];
-
-          ((BigInteger*)((memory*)m)->mpart)->count = x - 1;
-          carryAdd(((memory*)m)->mpart, 0, 0);
-
-          //move the value to corresponding BIT
-          memcpy(&((BIT*)((memory*)m)->biBIT)->BI[((BigInteger*)vb)->n[i]], ((memory*)m)->mpart, sizeof(BigInteger));
-          ((BIT*)((memory*)m)->biBIT)->status[((BigInteger*)vb)->n[i]] = 1;
-        } else
-          //we have a loaded BIT, so we copy it
-          memcpy(((memory*)m)->mpart, &((BIT*)((memory*)m)->biBIT)->BI[((BigInteger*)vb)->n[i]], sizeof(BigInteger));
-
-        //ponderate the result with "i" 0's
-        pMul(i, ((memory*)m)->mpart);
-
-        //add it
-        addition(((memory*)m)->mret, ((memory*)m)->mpart);
-
-        //init again
-        BImemcpy(((memory*)m)->mpart, 0);
+      na = lPack((BLlimb*)((memory*)m)->la, va);
+      hardEquals(va, vb, &comp);
+
+      //if |a| = |b|, we square it
+      if (comp == 0) {
+        nb = na;
+        lMulThreads((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->la, na, (BLlimb*)((memory*)m)->la, na,
+          (BLlimb*)((memory*)m)->lscr, ((memory*)m)->threads);
+      } else {
+        nb = lPack((BLlimb*)((memory*)m)->lb, vb);
+
+        lMulThreads((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->la, na, (BLlimb*)((memory*)m)->lb, nb,
+          (BLlimb*)((memory*)m)->lscr, ((memory*)m)->threads);
       }
 
       //move the result
-      memcpy(va, ((memory*)m)->mret, sizeof(BigInteger));
+      if (lUnpack(va, (BLlimb*)((memory*)m)->lr, na + nb) == 1)
+        showError(1);
     }
 
     //if signs are even, we switch it
@@ -1913,30 +2268,29 @@ static
 }
 
 /*
- * pMul.
+ * sSqr.
  *
- * Ponderates vpart a pos number of positions, leaving pos 0's on the right side
- * That's a fancy way to say it performs vpart = vpart * 10^pos
+ * Simulates a *= a
  */
-static void pMul(int pos, void* vpart) {
-  int i;
-
-  i = ((BigInteger*)vpart)->count + pos;
+#if BI_STANDALONE == 1
+static
+#endif
+ void sSqr(void* va, void* m) {
+  int na;
 
-  if (i >= MAX_LENGTH) {
-    showError(1);
+  if (((memory*)m)->la == NULL || ((memory*)m)->lr == NULL || ((memory*)m)->lscr == NULL) {
+    showError(3);
     return;
   }
 
-  //generate offset
-  for (; i >= pos; i--)
-    ((BigInteger*)vpart)->n[i] = ((BigInteger*)vpart)->n[i - pos];
+  //a^2 is always positive, and lPack drops the sign
+  na = lPack((BLlimb*)((memory*)m)->la, va);
 
-  //normalize offset positions
-  for (i = 0; i < pos; i++)
-    ((BigInteger*)vpart)->n[i] = 0;
+  lMulThreads((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->la, na, (BLlimb*)((memory*)m)->la, na,
+    (BLlimb*)((memory*)m)->lscr, ((memory*)m)->threads);
 
-  ((BigInteger*)vpart)->count += pos;
+  if (lUnpack(va, (BLlimb*)((memory*)m)->lr, 2 * na) == 1)
+    showError(1);
 }
 
 /*
@@ -1951,23 +2305,20 @@ static
   int sig;
   int comp;
 
-  if (((memory*)m)->dtmp == NULL || ((memory*)m)->done == NULL) {
+  if (((memory*)m)->dTemp == NULL) {
     showError(4);
     return;
   }
 
   //init decimal point
-  BI_point = -1;
+  ((memory*)m)->point = -1;
 
   if (va == vb) {
     //dvs(a, a)
-    BImemcpy(va, 1);
+    BIcopy(va, (void*)&_ONE);
+    BIzero(((memory*)m)->dTemp);
   } else {
     //dvs(a, b)
-
-    BImemcpy(((memory*)m)->dtmp, 0);
-    BImemcpy(((memory*)m)->done, 1);
-
     sig = signum(((BigInteger*)va)->n[((BigInteger*)va)->count],
       ((BigInteger*)vb)->n[((BigInteger*)vb)->count]);
 
@@ -1981,31 +2332,44 @@ static
       ((BigInteger*)vb)->n[((BigInteger*)vb)->count] *= -1;
     }
 
-    hardEquals(va, vb, &comp);
+    //if b = 0, we keep a / b = 0 and the remainder is a (as if a < b)
+    hardEquals(vb, (void*)&_ZERO, &comp);
+
+    if (comp == 0)
+      comp = 2;
+    else
+      hardEquals(va, vb, &comp);
 
     if (comp == 0) {
       //if a = b, a / b = 1
-      hardEquals(va, ((memory*)m)->dtmp, &comp);
+      hardEquals(va, (void*)&_ZERO, &comp);
 
       //with this we indicate there's no decimal point
-      BI_point = -2;
+      ((memory*)m)->point = -2;
 
       if (comp == 0)
         //if a = 0, then b = 0 (as a = b), then a / b = 0
-        memcpy(va, ((memory*)m)->dtmp, sizeof(BigInteger));
+        BIzero(va);
       else
         //otherwise, as a = b, a / b = 1
-        memcpy(va, ((memory*)m)->done, sizeof(BigInteger));
-    } else if (comp == 2)
-      //if a < b, then a / b = 0 (as we're on integer)
-      memcpy(va, ((memory*)m)->dtmp, sizeof(BigInteger));
-    else if (comp == 1) {
+        BIcopy(va, (void*)&_ONE);
+
+      //remainder is 0
+      BIzero(((memory*)m)->dTemp);
+    } else if (comp == 2) {
+      //if a < b, then a / b = 0 (as we're on integer) and the remainder is a
+      BIcopy(((memory*)m)->dTemp, va);
+      BIzero(va);
+    } else if (comp == 1) {
       //if a > b, then a / b = n
-      hardEquals(vb, ((memory*)m)->done, &comp);
+      hardEquals(vb, (void*)&_ONE, &comp);
 
       if (comp != 0)
         //only search n if b != 1
         divide(va, vb, m);
+      else
+        //remainder is 0
+        BIzero(((memory*)m)->dTemp);
     }
 
     //if sign are even, we switch the sign
@@ -2021,300 +2385,338 @@ static
 }
 
 /*
- * divide.
+ * sDivmod.
  *
- * Perform division via Bolzano
+ * Performs q = a / b and r = a % b with a single division. a and b are not modified.
+ * The quotient is truncated towards 0 and the remainder has the sign of a (as on C), so
+ * a = q * b + r. If b = 0, q = 0 and r = a.
+ *
+ * q and r shall be different pointers; any of them can be a (q can be b as well).
  */
-static void divide(void* va, void* vb, void* m) {
-  int len;
-  int i = 0;
-  int x = 0;
-  int eq;
-  int currentBIT;
-  int res = 0;
-  int added;
-  int dlen;
+#if BI_STANDALONE == 1
+static
+#endif
+ void sDivmod(void* vq, void* vr, void* va, void* vb, void* m) {
+  void* w = vq == vb ? vr : vq;
+  int sig = ((BigInteger*)va)->n[((BigInteger*)va)->count] < 0;
 
-  if (((memory*)m)->biBIT == NULL || ((memory*)m)->dTemp == NULL || ((memory*)m)->dret == NULL ||
-    ((memory*)m)->biTemp == NULL) {
-    showError(5);
+  if (((memory*)m)->dTemp == NULL) {
+    showError(4);
     return;
   }
 
-  BImemcpy(((memory*)m)->dret, 0);
-
-  len = ((BigInteger*)va)->count - ((BigInteger*)vb)->count;
+  //divide on q (or on r, if q is b). q and r can be unset, so they take a full copy
+  if (w != va)
+    memcpy(w, va, sizeof(BigInteger));
 
-  //init BIT
-  BImemcpy(&((BIT*)((memory*)m)->biBIT)->BI[0], 0);
-  memcpy(&((BIT*)((memory*)m)->biBIT)->BI[1], vb, sizeof(BigInteger));
+  sDvs(w, vb, m);
 
-  ((BIT*)((memory*)m)->biBIT)->status[0] = 1;
-  ((BIT*)((memory*)m)->biBIT)->status[1] = 1;
-  ((BIT*)((memory*)m)->biBIT)->status[2] = 0;
-  ((BIT*)((memory*)m)->biBIT)->status[3] = 0;
-  ((BIT*)((memory*)m)->biBIT)->status[4] = 0;
-  ((BIT*)((memory*)m)->biBIT)->status[5] = 0;
-  ((BIT*)((memory*)m)->biBIT)->status[6] = 0;
-  ((BIT*)((memory*)m)->biBIT)->status[7] = 0;
-  ((BIT*)((memory*)m)->biBIT)->status[8] = 0;
-  ((BIT*)((memory*)m)->biBIT)->status[9] = 0;
+  if (w != vq)
+    memcpy(vq, w, sizeof(BigInteger));
 
-  currentBIT = 1;
+  //the remainder is left on dTemp, without sign
+  memcpy(vr, ((memory*)m)->dTemp, sizeof(BigInteger));
 
-  //init dTemp
-  BImemcpy(((memory*)m)->dTemp, 0);
+  if (sig == 1)
+    ((BigInteger*)vr)->n[((BigInteger*)vr)->count] *= -1;
+}
 
-  /*
-   * Keep "b.count" first digits. If "b" has a single digit we don't move
-   * anything, because we later will move a digit.
-   */
-  if (((BigInteger*)vb)->count > 0)
-    for (; i < ((BigInteger*)vb)->count; i++)
-      ((BigInteger*)((memory*)m)->dTemp)->n[((BigInteger*)vb)->count - i - 1] = ((BigInteger*)va)->n[((BigInteger*)va)->count - i];
-  else
-    ((BigInteger*)((memory*)m)->dTemp)->n[0] = 0;
+/*
+ * divide.
+ *
+ * Perform division on the limb engine. The remainder is left on dTemp.
+ *
+ * If "a" is a BigDouble, the quotient is calculated with MAX_LENGTH - 1 digits (a is
+ * scaled by 10^n before dividing) and m->point keeps the decimal digits of the quotient (n).
+ */
+static void divide(void* va, void* vb, void* m) {
+  int len;
+  int na;
+  int nb;
+  int ta = ((BigInteger*)va)->count;
+  int tb = ((BigInteger*)vb)->count;
+  int shift = 0;
+
+  if (((memory*)m)->ld == NULL || ((memory*)m)->lb == NULL || ((memory*)m)->lr == NULL ||
+    ((memory*)m)->la == NULL || ((memory*)m)->ldscr == NULL || ((memory*)m)->dTemp == NULL) {
+    showError(5);
+    return;
+  }
 
-  ((BigInteger*)((memory*)m)->dTemp)->count = ((BigInteger*)vb)->count - 1;
+  //significant digits (BigDouble operands can come with 0's on the left)
+  while (ta > 0 && ((BigInteger*)va)->n[ta] == 0)
+    --ta;
 
-  if (((BigInteger*)((memory*)m)->dTemp)->count == -1)
-    ++((BigInteger*)((memory*)m)->dTemp)->count;
+  while (tb > 0 && ((BigInteger*)vb)->n[tb] == 0)
+    --tb;
 
-  //keep dlen for double calculation
-  dlen = len;
+  len = ta - tb;
 
   //init decimal point
-  BI_point = 0;
+  ((memory*)m)->point = 0;
 
   if (((BigInteger*)va)->k == 'd') {
-    if (len == 0)
-      BI_point = len;
-    else
-      BI_point = len - 1;
+    //quotient digits that fit, once the integer ones are placed
+    shift = MAX_LENGTH - 2 - len;
 
-    len = MAX_LENGTH - 1;
+    if (shift < 0)
+      shift = 0;
 
-    if (((BigInteger*)vb)->count == 0)
-      len = MAX_LENGTH - 2;
-    else
-      len = MAX_LENGTH - 1;
+    ((memory*)m)->point = shift;
   }
 
-  //for each digit we generated
-  for (i = 0; i <= len; i++) {
-    //make a temporal BI
-    if (i <= dlen)
-      //there are still digits
-      pAppend(((memory*)m)->dTemp, ((BigInteger*)va)->n[dlen - i]);
-    else
-      //no more digits, just carry a 0
-      pAppend(((memory*)m)->dTemp, 0);
+  na = lLen((BLlimb*)((memory*)m)->ld, lPackShift((BLlimb*)((memory*)m)->ld, va, shift));
+  nb = lLen((BLlimb*)((memory*)m)->lb, lPack((BLlimb*)((memory*)m)->lb, vb));
 
-    /*
-     * if b.len == 0, there's a bug on which the result of append has {n0} form with len = 1
-     * when it should have {n} form with len = 0 (it only happens during first iteration)
-     */
-    if (((BigInteger*)((memory*)m)->dTemp)->count == 1 && ((BigInteger*)((memory*)m)->dTemp)->n[1] == 0)
-      --((BigInteger*)((memory*)m)->dTemp)->count;
+  //a < b (a had 0's on the left) or b = 0: the quotient is 0 and the remainder is a
+  if (na < nb || nb == 0) {
+    BIcopy(((memory*)m)->dTemp, va);
+    recount(((memory*)m)->dTemp);
+    ((BigInteger*)((memory*)m)->dTemp)->k = 'i';
+    BIzero(va);
+    return;
+  }
 
-    hardEquals(((memory*)m)->dTemp, &((BIT*)((memory*)m)->biBIT)->BI[currentBIT], &eq);
+  lDivRem((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->la, (BLlimb*)((memory*)m)->ld, na,
+    (BLlimb*)((memory*)m)->lb, nb, (BLlimb*)((memory*)m)->ldscr);
 
-    x = currentBIT;
+  //move the remainder and the quotient
+  if (lUnpack(((memory*)m)->dTemp, (BLlimb*)((memory*)m)->la, nb) == 1 ||
+    lUnpack(va, (BLlimb*)((memory*)m)->lr, na - nb + 1) == 1)
+    showError(1);
+}
 
-    if (eq == 1) {
-      //if dTemp > BIT[x], we start from that value and keep going
-
-      //retrieve the last BI
-      memcpy(((memory*)m)->biTemp, &((BIT*)((memory*)m)->biBIT)->BI[x], sizeof(BigInteger));
-      added = 0;
-
-      for (; x < 10; x++) {
-        //add the base (vb)
-        pAdd(((memory*)m)->biTemp, vb, m);
-
-        //add it to BIT, if there's still space (we move it before validation)
-        if (currentBIT < 9) {
-          memcpy(&((BIT*)((memory*)m)->biBIT)->BI[++currentBIT], ((memory*)m)->biTemp, sizeof(BigInteger));
-          ((BIT*)((memory*)m)->biBIT)->status[currentBIT] = 1;
-          added = 1;
-        } else
-          added = 0;
-
-        //check if it fits
-        hardEquals(((memory*)m)->dTemp, ((memory*)m)->biTemp, &eq);
-
-        if (eq == 0) {
-          //if dTemp = temp
-          res = currentBIT;
-          x = 99;
-        } else if (eq == 2) {
-          /*
-           * if dTemp < temp, as Bolzano theoreme, we already went thru dTemp = temp.
-           * so, the correct value was the previous.
-           *
-           * If we didn't reach the end of the table (added == 1), the index will be the previous
-           * If we reached the end of the table (added == 0), the index will be the current
-           */
-          if (added == 1)
-            res = (currentBIT - 1);
-          else
-            res = currentBIT;
+/*
+ * bitLoad.
+ *
+ * Makes sure the BIT "vt" holds b: if it was built from other digits (or b changed since then),
+ * it's built again. Only count + 1 digits are compared, so a hit costs a memcmp. Returns 1 if b is 0.
+ */
+static int bitLoad(void* vt, void* vb, void* m) {
+  BIT* t = (BIT*)vt;
+  BigInteger* b = (BigInteger*)vb;
+
+  if (t->src.count != b->count || memcmp(t->src.n, b->n, (size_t)b->count + 1) != 0) {
+    memcpy(t->src.n, b->n, (size_t)b->count + 1);
+    t->src.k = 'i';
+    t->src.count = b->count;
+    t->nb = lLen(t->l, lPack(t->l, vb));
+
+    if (t->nb > 0)
+      lDivInit(&t->d, t->l, t->nb, (BLlimb*)((memory*)m)->ldscr);
+  }
 
-          x = 99;
-        }
-      }
-    } else if (eq == 0)
-      //if dTemp = BIT[x], we already have the value
-      res = currentBIT;
-    else if (eq == 2) {
-      //if dTemp < BIT[x], start for that value and go thru 0
-      --x;
-
-      for (; x >= 0; x--) {
-        //check if it fits
-        hardEquals(((memory*)m)->dTemp, &((BIT*)((memory*)m)->biBIT)->BI[x], &eq);
-
-        if (eq == 0) {
-          //if dTemp = temp
-          res = x;
-          x = -99;
-        } else if (eq == 1) {
-          /*
-           * if dtemp > temp, as Bolzano theoreme, we already went thru dTemp = temp,
-           * so, correct value is the next one.
-           */
-          res = x;
-          x = -99;
-        }
-      }
-    }
+  return t->nb == 0;
+}
+
+/*
+ * sBitInit.
+ *
+ * Builds the BIT "vt" (getBITSize() bytes) for b: its limbs and its divisor context (the
+ * normalized divisor, and its reciprocal for big divisors), so sBitMul, sBitDvs and sBitDivmod
+ * don't make them again while b keeps its value.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBitInit(void* vt, void* vb, void* m) {
+  if (((memory*)m)->ldscr == NULL) {
+    showError(13);
+    return;
+  }
 
-    //subtract. Can't call subtraction as pSub does main validations. #stackloop
-    pSub(((memory*)m)->dTemp, &((BIT*)((memory*)m)->biBIT)->BI[res], m);
+  //nothing can match a negative count
+  ((BIT*)vt)->src.count = -1;
+  bitLoad(vt, vb, m);
+}
 
-    if (i <= dlen)
-      ((BigInteger*)((memory*)m)->dret)->n[len - i] = res;
-    else {
-      //we're on the decimal zone. Check if it worth to add the data
-      if (((BigInteger*)((memory*)m)->dTemp)->count == 0 && ((BigInteger*)((memory*)m)->dTemp)->n[0] == 0) {
-        //we found a division with remainder = 0. There's no more data to treat and we finish
-        i = len + 1;
-      } else
-        //There's still data to treat, add it
-        ((BigInteger*)((memory*)m)->dret)->n[len - i] = res;
-    }
+/*
+ * sBitMul.
+ *
+ * Performs a *= b, taking the limbs of b from its BIT "vt".
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBitMul(void* va, void* vb, void* vt, void* m) {
+  BIT* t = (BIT*)vt;
+  BLlimb* la = (BLlimb*)((memory*)m)->la;
+  int na;
+  int sig;
+
+  if (la == NULL || ((memory*)m)->lr == NULL || ((memory*)m)->lscr == NULL || ((memory*)m)->ldscr == NULL) {
+    showError(3);
+    return;
   }
 
-  ((BigInteger*)((memory*)m)->dret)->count = len;
+  sig = (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0) != (((BigInteger*)vb)->n[((BigInteger*)vb)->count] < 0);
 
-  memcpy(va, ((memory*)m)->dret, sizeof(BigInteger));
+  if (bitLoad(vt, vb, m) == 1) {
+    BIzero(va);
+    return;
+  }
 
-  recount(va);
+  //mul(a, a): both operands are on the BIT
+  if (va == vb) {
+    la = t->l;
+    na = t->nb;
+  } else
+    na = lLen(la, lPack(la, va));
 
-  //avoid fake overflow error
-  if (((BigInteger*)va)->n[((BigInteger*)va)->count + 1] > 0)
-    ++((BigInteger*)va)->count;
+  if (na == 0) {
+    BIzero(va);
+    return;
+  }
+
+  lMulThreads((BLlimb*)((memory*)m)->lr, la, na, t->l, t->nb, (BLlimb*)((memory*)m)->lscr, ((memory*)m)->threads);
+
+  if (lUnpack(va, (BLlimb*)((memory*)m)->lr, na + t->nb) == 1) {
+    showError(1);
+    return;
+  }
+
+  if (sig == 1)
+    ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
 }
 
 /*
- * sNqrt.
+ * sBitDvs.
  *
- * Perform nth root of a.
+ * Performs a /= b (as sDvs, over integers), taking the divisor context of b from its BIT "vt".
+ * The remainder (without sign) is left on dTemp.
  */
 #if BI_STANDALONE == 1
 static
 #endif
- void sNqrt(void* va, int n, void* m) {
-  int lmax = 0;
-  int isEq = 0;
+ void sBitDvs(void* va, void* vb, void* vt, void* m) {
+  BIT* t = (BIT*)vt;
+  BigInteger* r = (BigInteger*)((memory*)m)->dTemp;
+  int na;
+  int sig;
 
-  if (((memory*)m)->sret == NULL || ((memory*)m)->sraw == NULL ||
-    ((memory*)m)->sbase == NULL || ((memory*)m)->szero == NULL) {
-    showError(9);
+  if (((memory*)m)->ld == NULL || ((memory*)m)->la == NULL || ((memory*)m)->lr == NULL ||
+    ((memory*)m)->ldscr == NULL || r == NULL) {
+    showError(5);
     return;
   }
 
-  BImemcpy(((memory*)m)->sbase, 0);
-  BImemcpy(((memory*)m)->szero, 0);
+  sig = (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0) != (((BigInteger*)vb)->n[((BigInteger*)vb)->count] < 0);
 
-  //if root index is 0, return 0
-  if (n <= 0) {
-    memcpy(va, ((memory*)m)->szero, sizeof(BigInteger));
+  //if b = 0 or |a| has less limbs than b, a / b = 0 and the remainder is |a|
+  if (bitLoad(vt, vb, m) == 1 || (na = lLen((BLlimb*)((memory*)m)->ld, lPack((BLlimb*)((memory*)m)->ld, va))) < t->nb) {
+    BIcopy(r, va);
 
+    if (r->n[r->count] < 0)
+      r->n[r->count] *= -1;
+
+    BIzero(va);
+    return;
+  }
+
+  lDivPre((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->la, (BLlimb*)((memory*)m)->ld, na, &t->d,
+    (BLlimb*)((memory*)m)->ldscr);
+
+  //move the remainder and the quotient
+  if (lUnpack(r, (BLlimb*)((memory*)m)->la, t->nb) == 1 ||
+    lUnpack(va, (BLlimb*)((memory*)m)->lr, na - t->nb + 1) == 1) {
+    showError(1);
     return;
   }
 
-  //as default behaviour, the nth root of a number will have half the digits #ToDo: review/optimize
-  lmax = ((BigInteger*)va)->count / 2;
+  if (sig == 1)
+    ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
+}
+
+/*
+ * sBitDivmod.
+ *
+ * Performs q = a / b and r = a % b (as sDivmod), taking the divisor context of b from its
+ * BIT "vt".
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBitDivmod(void* vq, void* vr, void* va, void* vb, void* vt, void* m) {
+  void* w = vq == vb ? vr : vq;
+  int sig = ((BigInteger*)va)->n[((BigInteger*)va)->count] < 0;
+
+  if (((memory*)m)->dTemp == NULL) {
+    showError(4);
+    return;
+  }
 
-  //creat a base
-  ((BigInteger*)((memory*)m)->sbase)->n[lmax] = 1;
-  ((BigInteger*)((memory*)m)->sbase)->count = lmax;
+  //divide on q (or on r, if q is b). q and r can be unset, so they take a full copy
+  if (w != va)
+    memcpy(w, va, sizeof(BigInteger));
 
-  //use Bolzano to get an approximation
-  memcpy(((memory*)m)->sret, ((memory*)m)->sbase, sizeof(BigInteger));
-  memcpy(((memory*)m)->sraw, ((memory*)m)->sbase, sizeof(BigInteger));
+  sBitDvs(w, vb, vt, m);
 
-  //calculate the power
-  sBipow(((memory*)m)->sret, n, m);
-  hardEquals(((memory*)m)->sret, va, &isEq);
+  if (w != vq)
+    memcpy(vq, w, sizeof(BigInteger));
 
-  while (isEq != 0) {
-    while (isEq == 2) {
-      //ret < a. Increase and try again until overflow
-      addition(((memory*)m)->sraw, ((memory*)m)->sbase);
+  //the remainder is left on dTemp, without sign
+  memcpy(vr, ((memory*)m)->dTemp, sizeof(BigInteger));
 
-      memcpy(((memory*)m)->sret, ((memory*)m)->sraw, sizeof(BigInteger));
+  if (sig == 1)
+    ((BigInteger*)vr)->n[((BigInteger*)vr)->count] *= -1;
+}
 
-      sBipow(((memory*)m)->sret, n, m);
-      hardEquals(((memory*)m)->sret, va, &isEq);
-    }
+/*
+ * sNqrt.
+ *
+ * Perform nth root of a (truncated towards 0) on the limb engine. Even roots of negative
+ * numbers, as well as n <= 0, give 0.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sNqrt(void* va, int n, void* m) {
+  int na;
+  int sig = ((BigInteger*)va)->n[((BigInteger*)va)->count] < 0;
 
-    //once here, it will always happens that ret >= a
-    if (isEq == 1) {
-      //if a > ret, get back 1 base position and go adjust the previous position. #stackloop
-      pSub(((memory*)m)->sraw, ((memory*)m)->sbase, m);
+  if (((memory*)m)->la == NULL || ((memory*)m)->lr == NULL || ((memory*)m)->lsscr == NULL) {
+    showError(9);
+    return;
+  }
 
-      ((BigInteger*)((memory*)m)->sbase)->n[lmax] = 0;
-      --lmax;
+  //if root index is 0, return 0
+  if (n <= 0 || (sig == 1 && n % 2 == 0)) {
+    BIzero(va);
 
-      if (lmax >= 0) {
-        //if lmax is greater than 0, we still have digits to pivot
-        ((BigInteger*)((memory*)m)->sbase)->n[lmax] = 1;
-        --((BigInteger*)((memory*)m)->sbase)->count;
+    return;
+  }
 
-        //calculate power and compare (always will be a < ret, because a = ret case won't enter this if).
-        hardEquals(((memory*)m)->sbase, ((memory*)m)->szero, &isEq);
+  na = lPack((BLlimb*)((memory*)m)->la, va);
+  na = lRoot((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->la, na, n, (BLlimb*)((memory*)m)->lsscr);
 
-        //if base > 0, we still have to iterate
-        if (isEq == 1)
-          isEq = 2;
-        else
-          //on the opposite case, we reached maximum possible aproximation
-          isEq = 0;
-      } else
-        //if lmax is lower than 0, we reached maximum possible approximation
-        isEq = 0;
-    }
+  if (lUnpack(va, (BLlimb*)((memory*)m)->lr, na) == 1) {
+    showError(1);
+    return;
   }
 
-  memcpy(va, ((memory*)m)->sraw, sizeof(BigInteger));
+  if (sig == 1)
+    ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
 }
 
 /*
  * sBipow.
  *
- * Performs a ^= p
+ * Performs a ^= p with left-to-right sliding windows: the odd powers a, a^3, ..., are kept
+ * on btmp, and every window of p (up to BIPOW_WINDOW bits ending on a 1) costs one
+ * multiplication besides the squarings.
  */
 #if BI_STANDALONE == 1
 static
 #endif
 void sBipow(void* va, int p, void* m) {
-  int d2b[10];
-  int d2bi = 0;
-  int x = 0;
-  int t = p;
-  int i = 0;
+  BigInteger* g = (BigInteger*)((memory*)m)->btmp;
+  int bits = 0;
+  int w = 1;
+  int i;
+  int j;
+  int l;
+  int v;
+  int first = 1;
   int sig = 0;
 
   if (((memory*)m)->bres == NULL || ((memory*)m)->btmp == NULL) {
@@ -2323,94 +2725,620 @@ void sBipow(void* va, int p, void* m) {
   }
 
   if (p < 0) {
-    BImemcpy(va, 0);
+    BIzero(va);
 
     return;
   }
 
-  BImemcpy(((memory*)m)->bres, 1);
+  //normalize va
+  if (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0) {
+    sig = p % 2;
+    ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
+  }
 
-  /*
-   *  Factorize the power on base-2 so we can improve performance
-   *  of the operation.
-   *
-   *  How it works
-   *   - Convert exponent on base-2, and store data on an array
-   *
-   *   - For each iteration, we keep calculating a^2^i, that means
-   *     a^0, a^2, a^4, a^8, a^16, ...
-   *
-   *   - If d2b position is 1, multiply, and this way we get the result
-   *
-   *     Example: 8^12
-   *       12 = 1100 (but keeps stored as 0011) ==> 4 + 8
-   *       8^12 = 8^4 * 8^8 = 8^(4+8)
-   *
-   *     With this way, we only do 8 multiplications instead of 12 (on this
-   *     example). On larger numbers, the difference is still greater
-   */
-   //decimal to binary conversion
-  while (t > 0 && d2bi < 10) {
-    //divide by two
-    x = t / 2;
+  //0^p, 1^p and a^0 don't need any calculation
+  if (p == 0 || (((BigInteger*)va)->count == 0 && ((BigInteger*)va)->n[0] <= 1)) {
+    if (p == 0 || ((BigInteger*)va)->n[0] == 1)
+      BIcopy(va, (void*)&_ONE);
+    else
+      BIzero(va);
 
-    //keep the remainder on d2b
-    d2b[d2bi++] = (t - x * 2);
+    if (sig == 1)
+      ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
 
-    //reassign value
-    t = x;
+    return;
   }
 
-  //if there's a really big number, we throw an error
-  if (t > 0 && d2bi >= 10) {
-    showError(8);
+  //a >= 2, so a^p has, at least, p * log10(2) digits (and count * p + 1 digits)
+  if ((long long)p * 30103 >= (long long)MAX_LENGTH * 100000 ||
+    (long long)((BigInteger*)va)->count * p >= MAX_LENGTH) {
+    showError(1);
     return;
   }
 
-  //normalize va
-  if (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0) {
-    sig = 1;
-    ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
+  for (i = p; i > 0; i >>= 1)
+    ++bits;
+
+  if (bits > 23)
+    w = 3;
+  else if (bits > 1)
+    w = 2;
+
+  if (w > BIPOW_WINDOW)
+    w = BIPOW_WINDOW;
+
+  //odd powers: g[i] = a^(2i + 1). bres is used to keep a^2
+  BIcopy(&g[0], va);
+
+  if (w > 1) {
+    BIcopy(((memory*)m)->bres, va);
+    sSqr(((memory*)m)->bres, m);
+
+    for (i = 1; i < (1 << (w - 1)); i++) {
+      BIcopy(&g[i], &g[i - 1]);
+      sMul(&g[i], ((memory*)m)->bres, m);
+    }
   }
 
-  //iterate over binary number
-  for (; i < d2bi; i++) {
-    //calculate (a^(2^i))
-    if (i == 0)
-      memcpy(((memory*)m)->btmp, va, sizeof(BigInteger));
-    else
-      sMul(((memory*)m)->btmp, ((memory*)m)->btmp, m);
+  for (i = bits - 1; i >= 0;) {
+    if (((p >> i) & 1) == 0) {
+      sSqr(((memory*)m)->bres, m);
+      --i;
+
+      continue;
+    }
+
+    //the window ends on the lowest set bit, at most w bits below
+    j = i - w + 1 < 0 ? 0 : i - w + 1;
+
+    while (((p >> j) & 1) == 0)
+      ++j;
 
-    if (d2b[i] == 1)
-      sMul(((memory*)m)->bres, ((memory*)m)->btmp, m);
+    v = (p >> j) & ((1 << (i - j + 1)) - 1);
+
+    if (first == 1) {
+      BIcopy(((memory*)m)->bres, &g[v >> 1]);
+      first = 0;
+    } else {
+      for (l = i; l >= j; l--)
+        sSqr(((memory*)m)->bres, m);
+
+      sMul(((memory*)m)->bres, &g[v >> 1], m);
+    }
+
+    i = j - 1;
   }
 
-  //revert va if exponent is even
-  if (sig == 1 && p % 2 == 1)
-    ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
+  BIcopy(va, ((memory*)m)->bres);
 
-  memcpy(va, ((memory*)m)->bres, sizeof(BigInteger));
+  //odd powers of negative numbers are negative
+  if (sig == 1)
+    ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
 }
 
-#if BI_STANDALONE == 1
 /*
- * add. Use it to add two numbers.
+ * sBipowBI.
+ *
+ * Performs a ^= e, being e a BigInteger. Beyond 0, 1 and -1, a^e only fits on MAX_LENGTH
+ * digits for small exponents, so e >= 10^9 is only accepted for those bases.
  */
-void add(void* va, void* vb, void* m) {
-  //validate data before treating
-  if (validate == 1) {
-    validateBI(va);
-    validateBI(vb);
+#if BI_STANDALONE == 1
+static
+#endif
+void sBipowBI(void* va, void* ve, void* m) {
+  int p = 0;
+  int i = ((BigInteger*)ve)->count;
+
+  if (((BigInteger*)ve)->n[i] < 0) {
+    BIzero(va);
+
+    return;
   }
 
-  //delegate on static function
-  pAdd(va, vb, m);
+  if (i >= 9) {
+    if (((BigInteger*)va)->count > 0 || ((BigInteger*)va)->n[0] < -1 || ((BigInteger*)va)->n[0] > 1) {
+      showError(8);
+      return;
+    }
+
+    //for 0, 1 and -1, only the parity matters
+    p = 2 - ((BigInteger*)ve)->n[0] % 2;
+  } else {
+    for (; i >= 0; i--)
+      p = p * 10 + ((BigInteger*)ve)->n[i];
+  }
+
+  sBipow(va, p, m);
 }
 
 /*
- * sub. Use it to subtract two numbers.
+ * sBarrettInit.
+ *
+ * Loads the modulus n (n > 0) on the Barrett context "vc" (getBarrettSize() bytes), so
+ * floor(b^2k / n) is computed once and reused on every bmod.
  */
-void sub(void* va, void* vb, void* m) {
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBarrettInit(void* vc, void* vn, void* m) {
+  int k;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lmscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  k = lLen((BLlimb*)((memory*)m)->la, lPack((BLlimb*)((memory*)m)->la, vn));
+
+  //the modulus shall be positive
+  if (k == 0 || ((BigInteger*)vn)->n[((BigInteger*)vn)->count] < 0) {
+    showError(13);
+    return;
+  }
+
+  lBarrettInit((BLbarrett*)vc, (BLlimb*)((memory*)m)->la, k, (BLlimb*)((memory*)m)->lmscr);
+}
+
+/*
+ * sBmod.
+ *
+ * Performs a = a mod n, being n the modulus of the Barrett context. As on mod, the
+ * remainder is taken over the absolute value of a.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBmod(void* va, void* vc, void* m) {
+  int na;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lr == NULL || ((memory*)m)->lmscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  na = lPack((BLlimb*)((memory*)m)->la, va);
+
+  lBarrett((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->la, na, (BLbarrett*)vc,
+    (BLlimb*)((memory*)m)->lmscr);
+
+  if (lUnpack(va, (BLlimb*)((memory*)m)->lr, ((BLbarrett*)vc)->k) == 1)
+    showError(1);
+}
+
+/*
+ * sMontInit.
+ *
+ * Loads the modulus n (n > 0) on the Montgomery context "vc" (getMontSize() bytes), so
+ * R^2 mod n and -n^-1 are computed once and reused on every modmul, modsqr and modpow.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sMontInit(void* vc, void* vn, void* m) {
+  int k;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lmscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  k = lLen((BLlimb*)((memory*)m)->la, lPack((BLlimb*)((memory*)m)->la, vn));
+
+  //the modulus shall be positive
+  if (k == 0 || ((BigInteger*)vn)->n[((BigInteger*)vn)->count] < 0) {
+    showError(13);
+    return;
+  }
+
+  lMontInit((BLmont*)vc, (BLlimb*)((memory*)m)->la, k, (BLlimb*)((memory*)m)->lmscr);
+}
+
+/*
+ * lModLoad.
+ *
+ * Moves a (any size and sign) into r, reduced and on Montgomery form: r = a * R mod n.
+ */
+static void lModLoad(BLlimb* r, void* va, void* vc, void* m) {
+  int na = lPack((BLlimb*)((memory*)m)->la, va);
+
+  lMontTo(r, (BLlimb*)((memory*)m)->la, na, (BLmont*)vc, (BLlimb*)((memory*)m)->lmscr);
+
+  //-a mod n = n - (a mod n)
+  if (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0 && lLen(r, ((BLmont*)vc)->k) > 0)
+    lSbb(r, ((BLmont*)vc)->n, r, ((BLmont*)vc)->k, 0);
+}
+
+/*
+ * lModStore.
+ *
+ * Moves r (on Montgomery form) out to a, as a value on [0, n).
+ */
+static void lModStore(void* va, BLlimb* r, void* vc, void* m) {
+  lMontFrom(r, r, (BLmont*)vc, (BLlimb*)((memory*)m)->lmscr);
+
+  if (lUnpack(va, r, ((BLmont*)vc)->k) == 1)
+    showError(1);
+}
+
+/*
+ * sModmul.
+ *
+ * Performs a = a * b mod n, being n the modulus of the context. The result is on [0, n).
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sModmul(void* va, void* vb, void* vc, void* m) {
+  if (((memory*)m)->la == NULL || ((memory*)m)->lr == NULL || ((memory*)m)->ld == NULL ||
+    ((memory*)m)->lmscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  lModLoad((BLlimb*)((memory*)m)->lr, va, vc, m);
+  lModLoad((BLlimb*)((memory*)m)->ld, vb, vc, m);
+
+  lMontMul((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->ld,
+    (BLmont*)vc, (BLlimb*)((memory*)m)->lmscr);
+
+  lModStore(va, (BLlimb*)((memory*)m)->lr, vc, m);
+}
+
+/*
+ * sModsqr.
+ *
+ * Performs a = a^2 mod n, being n the modulus of the context. The result is on [0, n).
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sModsqr(void* va, void* vc, void* m) {
+  if (((memory*)m)->la == NULL || ((memory*)m)->lr == NULL || ((memory*)m)->lmscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  lModLoad((BLlimb*)((memory*)m)->lr, va, vc, m);
+
+  lMontMul((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->lr,
+    (BLmont*)vc, (BLlimb*)((memory*)m)->lmscr);
+
+  lModStore(va, (BLlimb*)((memory*)m)->lr, vc, m);
+}
+
+/*
+ * sModpow.
+ *
+ * Performs a = a^e mod n, being n the modulus of the context, with sliding windows.
+ * Every intermediate value stays below n, so neither the exponent size nor a^e are limited
+ * by MAX_LENGTH. As on sBipow, a negative exponent gives 0.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sModpow(void* va, void* ve, void* vc, void* m) {
+  int ne;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lb == NULL || ((memory*)m)->lr == NULL ||
+    ((memory*)m)->ld == NULL || ((memory*)m)->lmscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  if (((BigInteger*)ve)->n[((BigInteger*)ve)->count] < 0) {
+    BIzero(va);
+    return;
+  }
+
+  lModLoad((BLlimb*)((memory*)m)->ld, va, vc, m);
+  ne = lPack((BLlimb*)((memory*)m)->lb, ve);
+
+  lMontPow((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->ld, (BLlimb*)((memory*)m)->lb, ne,
+    (BLmont*)vc, (BLlimb*)((memory*)m)->lmscr);
+
+  lModStore(va, (BLlimb*)((memory*)m)->lr, vc, m);
+}
+
+/*
+ * sGcd.
+ *
+ * Performs a = gcd(a, b) on the limb engine (Lehmer steps, and binary GCD for the last word).
+ * The result is always positive, and gcd(0, 0) = 0.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sGcd(void* va, void* vb, void* m) {
+  int na;
+  int nb;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lb == NULL || ((memory*)m)->lr == NULL ||
+    ((memory*)m)->lgscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  na = lPack((BLlimb*)((memory*)m)->la, va);
+  nb = lPack((BLlimb*)((memory*)m)->lb, vb);
+
+  if (lUnpack(va, (BLlimb*)((memory*)m)->lr, lGcd((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->la, na,
+    (BLlimb*)((memory*)m)->lb, nb, (BLlimb*)((memory*)m)->lgscr)) == 1)
+    showError(1);
+}
+
+/*
+ * sXgcd.
+ *
+ * Performs g = gcd(a, b) and gets x, y such that x * a + y * b = g (|x| <= |b| / g and |y| <= |a| / g).
+ * g, x and y shall be different pointers; any of them can be a or b, or unset.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sXgcd(void* vg, void* vx, void* vy, void* va, void* vb, void* m) {
+  int na;
+  int nb;
+  int ng;
+  int nx;
+  int ny;
+  char sx;
+  int sa = ((BigInteger*)va)->n[((BigInteger*)va)->count] < 0;
+  int sb = ((BigInteger*)vb)->n[((BigInteger*)vb)->count] < 0;
+  BLlimb* y = (BLlimb*)((memory*)m)->ld + L_MAX_LENGTH + 1;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lb == NULL || ((memory*)m)->lr == NULL ||
+    ((memory*)m)->ld == NULL || ((memory*)m)->lgscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  na = lPack((BLlimb*)((memory*)m)->la, va);
+  nb = lPack((BLlimb*)((memory*)m)->lb, vb);
+
+  ng = lXgcd((BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->ld, &nx, &sx, y, &ny,
+    (BLlimb*)((memory*)m)->la, na, (BLlimb*)((memory*)m)->lb, nb, (BLlimb*)((memory*)m)->lgscr);
+
+  //g, x and y can be unset (a and b are already packed), so they take a full clear
+  BImemcpy(vg, 0);
+  BImemcpy(vx, 0);
+  BImemcpy(vy, 0);
+
+  if (lUnpack(vg, (BLlimb*)((memory*)m)->lr, ng) == 1 || lUnpack(vx, (BLlimb*)((memory*)m)->ld, nx) == 1 ||
+    lUnpack(vy, y, ny) == 1) {
+    showError(1);
+    return;
+  }
+
+  //cofactors were got for |a| and |b|. y has the opposite sign of x (positive if x = 0)
+  if ((sx == -1) != sa && nx > 0)
+    ((BigInteger*)vx)->n[((BigInteger*)vx)->count] *= -1;
+
+  if ((sx == 0 && nx > 0) != sb && ny > 0)
+    ((BigInteger*)vy)->n[((BigInteger*)vy)->count] *= -1;
+}
+
+/*
+ * sModinv.
+ *
+ * Performs a = a^-1 mod n (0 <= a < |n|). If a and n are not coprime, a is kept and error 13 is raised.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sModinv(void* va, void* vn, void* m) {
+  int na;
+  int nn;
+  int nr;
+  int sa = ((BigInteger*)va)->n[((BigInteger*)va)->count] < 0;
+  BLlimb* r = (BLlimb*)((memory*)m)->lr;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lb == NULL || ((memory*)m)->lr == NULL ||
+    ((memory*)m)->lgscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  na = lPack((BLlimb*)((memory*)m)->la, va);
+  nn = lPack((BLlimb*)((memory*)m)->lb, vn);
+
+  nr = lModInv(r, (BLlimb*)((memory*)m)->la, na, (BLlimb*)((memory*)m)->lb, nn, (BLlimb*)((memory*)m)->lgscr);
+
+  if (nr < 0) {
+    showError(13);
+    return;
+  }
+
+  //(-a)^-1 = n - a^-1
+  if (sa == 1 && nr > 0) {
+    memset(r + nr, 0, sizeof(BLlimb) * (nn - nr));
+    lSbb(r, (BLlimb*)((memory*)m)->lb, r, nn, 0);
+    nr = nn;
+  }
+
+  if (lUnpack(va, r, nr) == 1)
+    showError(1);
+}
+
+/*
+ * sIsPrime.
+ *
+ * Returns 1 if a is prime (or a probable prime) and 0 otherwise: trial division by the primes below
+ * 2048, and then Baillie-PSW and "rounds" more Miller-Rabin rounds over a Montgomery context (lIsPrime).
+ * Negative numbers, 0 and 1 are not prime.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ int sIsPrime(void* va, int rounds, void* m) {
+  if (((memory*)m)->la == NULL || ((memory*)m)->lpscr == NULL) {
+    showError(13);
+    return 0;
+  }
+
+  if (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0)
+    return 0;
+
+  return lIsPrime((BLlimb*)((memory*)m)->la, lPack((BLlimb*)((memory*)m)->la, va), rounds,
+    (BLlimb*)((memory*)m)->lpscr);
+}
+
+/*
+ * sPrimeSieve.
+ *
+ * Tests a, a + 1, ..., a + len - 1 as sIsPrime does, leaving 1 (prime) or 0 on res[i]. The range is
+ * sieved with the small primes first, so only the survivors are tested. Returns how many primes there are.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ int sPrimeSieve(void* va, int len, char* res, int rounds, void* m) {
+  int na;
+  long long off = 0;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lpscr == NULL) {
+    showError(13);
+    return 0;
+  }
+
+  if (len <= 0)
+    return 0;
+
+  na = lLen((BLlimb*)((memory*)m)->la, lPack((BLlimb*)((memory*)m)->la, va));
+
+  //a < 0: there's no prime up to 0
+  if (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0) {
+    off = len;
+
+    if (na <= 2)
+      off = ((BLlimb*)((memory*)m)->la)[0] + (na == 2 ? (long long)((BLlimb*)((memory*)m)->la)[1] * BL_BASE : 0);
+
+    if (off >= len) {
+      memset(res, 0, len);
+      return 0;
+    }
+
+    memset(res, 0, (size_t)off);
+    na = 0;
+  }
+
+  return lPrimeSieve(res + off, (BLlimb*)((memory*)m)->la, na, len - (int)off, rounds,
+    (BLlimb*)((memory*)m)->lpscr);
+}
+
+/*
+ * sAccAdd.
+ *
+ * Performs c += a (or c -= a if sig is -1) on the accumulator "vc" (getAccSize() bytes). The
+ * digits go straight to the digit lanes: carries wait until sAccGet.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sAccAdd(void* vc, void* va, int sig, void* m) {
+  //m is not needed (no scratch buffers), it's kept to match sAccMul
+  (void)m;
+
+  if (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0)
+    sig = sig == -1 ? 0 : -1;
+
+  if (lAccDigits((BLacc*)vc, ((BigInteger*)va)->n, ((BigInteger*)va)->count + 1, sig) == 1)
+    showError(1);
+}
+
+/*
+ * sAccMul.
+ *
+ * Performs c += a * b on the accumulator "vc". Small products are added by columns, with no carries.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sAccMul(void* vc, void* va, void* vb, void* m) {
+  int na;
+  int nb;
+  int sig = 0;
+
+  if (((memory*)m)->la == NULL || ((memory*)m)->lb == NULL || ((memory*)m)->lr == NULL || ((memory*)m)->lscr == NULL) {
+    showError(13);
+    return;
+  }
+
+  na = lPack((BLlimb*)((memory*)m)->la, va);
+  nb = lPack((BLlimb*)((memory*)m)->lb, vb);
+
+  if ((((BigInteger*)va)->n[((BigInteger*)va)->count] < 0) != (((BigInteger*)vb)->n[((BigInteger*)vb)->count] < 0))
+    sig = -1;
+
+  if (lAccMul((BLacc*)vc, (BLlimb*)((memory*)m)->la, na, (BLlimb*)((memory*)m)->lb, nb, sig,
+    (BLlimb*)((memory*)m)->lr, (BLlimb*)((memory*)m)->lscr) == 1)
+    showError(1);
+}
+
+/*
+ * sAccDot.
+ *
+ * Performs c += a[0] * b[0] + ... + a[n - 1] * b[n - 1] on the accumulator "vc", being va and vb
+ * arrays of n BigIntegers.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sAccDot(void* vc, void* va, void* vb, int n, void* m) {
+  int i = 0;
+
+  for (; i < n; i++)
+    sAccMul(vc, (BigInteger*)va + i, (BigInteger*)vb + i, m);
+}
+
+/*
+ * sAccGet.
+ *
+ * Propagates the carries of the accumulator "vc" and moves its value to a. The accumulator
+ * keeps it, so it can go on adding.
+ */
+#if BI_STANDALONE == 1
+static
+#endif
+ void sAccGet(void* va, void* vc, void* m) {
+  int k;
+  char sig;
+
+  if (((memory*)m)->lr == NULL) {
+    showError(13);
+    return;
+  }
+
+  ((BigInteger*)va)->k = 'i';
+  k = lAccGet((BLlimb*)((memory*)m)->lr, &sig, (BLacc*)vc);
+
+  if (k < 0 || lUnpack(va, (BLlimb*)((memory*)m)->lr, k) == 1) {
+    showError(1);
+    return;
+  }
+
+  if (sig == -1)
+    ((BigInteger*)va)->n[((BigInteger*)va)->count] *= -1;
+}
+
+#if BI_STANDALONE == 1
+/*
+ * add. Use it to add two numbers.
+ */
+void add(void* va, void* vb, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  pAdd(va, vb, m);
+}
+
+/*
+ * sub. Use it to subtract two numbers.
+ */
+void sub(void* va, void* vb, void* m) {
   //validate data before treating
   if (validate == 1) {
     validateBI(va);
@@ -2446,7 +3374,7 @@ void dvs(void* va, void* vb, void* m) {
   }
 
   //init the decimal point
-  BI_point = 0;
+  ((memory*)m)->point = 0;
 
   //delegate on static function
   sDvs(va, vb, m);
@@ -2474,7 +3402,7 @@ void bipow(void* va, int p, void* m) {
 
   if (p == 0)
     //n^0 = 1
-    BImemcpy(va, 1);
+    BIcopy(va, (void*)&_ONE);
   else if (p == 1)
     //n^1 = n
     return;
@@ -2482,6 +3410,20 @@ void bipow(void* va, int p, void* m) {
     sBipow(va, p, m);
 }
 
+/*
+ * bipowBI. Use it to get the "e" power of a number, being "e" a BigInteger.
+ */
+void bipowBI(void* va, void* ve, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(ve);
+  }
+
+  //delegate on static function
+  sBipowBI(va, ve, m);
+}
+
 /*
  * mod. Use it to get the "b" module of a number.
  */
@@ -2496,7 +3438,323 @@ void mod(void* va, void* vb, void* m) {
   sDvs(va, vb, m);
 
   //copy the remainder of the divison
-  memcpy(va, ((memory*)m)->dTemp, sizeof(BigInteger));
+  BIcopy(va, ((memory*)m)->dTemp);
+}
+
+/*
+ * divmod. Use it to get the quotient and the remainder of a division at once.
+ *
+ * q = a / b (truncated towards 0) and r = a % b (with the sign of a).
+ */
+void divmod(void* vq, void* vr, void* va, void* vb, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  sDivmod(vq, vr, va, vb, m);
+}
+
+/*
+ * bitInit. Use it to pin b on a BIT (getBITSize() bytes) for bitMul, bitDvs and bitDivmod.
+ */
+void bitInit(void* vt, void* vb, void* m) {
+  //validate data before treating
+  if (validate == 1)
+    validateBI(vb);
+
+  //delegate on static function
+  sBitInit(vt, vb, m);
+}
+
+/*
+ * bitMul. Use it to multiply by a pinned number (b is built again on the BIT if it changed).
+ */
+void bitMul(void* va, void* vb, void* vt, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  sBitMul(va, vb, vt, m);
+}
+
+/*
+ * bitDvs. Use it to divide by a pinned number (b is built again on the BIT if it changed).
+ */
+void bitDvs(void* va, void* vb, void* vt, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  sBitDvs(va, vb, vt, m);
+}
+
+/*
+ * bitDivmod. Use it to get quotient and remainder by a pinned number.
+ */
+void bitDivmod(void* vq, void* vr, void* va, void* vb, void* vt, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  sBitDivmod(vq, vr, va, vb, vt, m);
+}
+
+/*
+ * barrettInit. Use it to load a modulus on a Barrett context (getBarrettSize() bytes).
+ */
+void barrettInit(void* vc, void* vn, void* m) {
+  //validate data before treating
+  if (validate == 1)
+    validateBI(vn);
+
+  //delegate on static function
+  sBarrettInit(vc, vn, m);
+}
+
+/*
+ * bmod. Use it to get the module of a number by the modulus of a Barrett context.
+ */
+void bmod(void* va, void* vc, void* m) {
+  //validate data before treating
+  if (validate == 1)
+    validateBI(va);
+
+  //delegate on static function
+  sBmod(va, vc, m);
+}
+
+/*
+ * montInit. Use it to load a modulus on a Montgomery context (getMontSize() bytes).
+ */
+void montInit(void* vc, void* vn, void* m) {
+  //validate data before treating
+  if (validate == 1)
+    validateBI(vn);
+
+  //delegate on static function
+  sMontInit(vc, vn, m);
+}
+
+/*
+ * modmul. Use it to get a * b mod n, being n the modulus of the context.
+ */
+void modmul(void* va, void* vb, void* vc, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  sModmul(va, vb, vc, m);
+}
+
+/*
+ * modsqr. Use it to get a^2 mod n, being n the modulus of the context.
+ */
+void modsqr(void* va, void* vc, void* m) {
+  //validate data before treating
+  if (validate == 1)
+    validateBI(va);
+
+  //delegate on static function
+  sModsqr(va, vc, m);
+}
+
+/*
+ * modpow. Use it to get a^e mod n, being n the modulus of the context.
+ */
+void modpow(void* va, void* ve, void* vc, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(ve);
+  }
+
+  //delegate on static function
+  sModpow(va, ve, vc, m);
+}
+
+/*
+ * gcd. Use it to get the greatest common divisor of a and b (on a).
+ */
+void gcd(void* va, void* vb, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  sGcd(va, vb, m);
+}
+
+/*
+ * xgcd. Use it to get g = gcd(a, b) and x, y such that x * a + y * b = g.
+ */
+void xgcd(void* vg, void* vx, void* vy, void* va, void* vb, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  sXgcd(vg, vx, vy, va, vb, m);
+}
+
+/*
+ * modinv. Use it to get a^-1 mod n.
+ */
+void modinv(void* va, void* vn, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vn);
+  }
+
+  //delegate on static function
+  sModinv(va, vn, m);
+}
+
+/*
+ * isProbablePrime. Use it to know if a is prime (1) or not (0). "rounds" adds Miller-Rabin rounds
+ * to the Baillie-PSW test (0 is enough, as there's no known Baillie-PSW pseudoprime).
+ */
+int isProbablePrime(void* va, int rounds, void* m) {
+  //validate data before treating
+  if (validate == 1)
+    validateBI(va);
+
+  //delegate on static function
+  return sIsPrime(va, rounds, m);
+}
+
+/*
+ * primeSieve. Use it to test the range a, a + 1, ..., a + len - 1 (res[i] gets 1 if a + i is prime).
+ * Returns how many primes there are on the range.
+ */
+int primeSieve(void* va, int len, char* res, int rounds, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+
+    if (res == NULL) {
+      showError(13);
+      return 0;
+    }
+  }
+
+  //delegate on static function
+  return sPrimeSieve(va, len, res, rounds, m);
+}
+
+/*
+ * accInit. Use it to set an accumulator (getAccSize() bytes) to 0.
+ */
+void accInit(void* vc) {
+  lAccInit((BLacc*)vc);
+}
+
+/*
+ * accAdd. Use it to add a number to an accumulator.
+ */
+void accAdd(void* vc, void* va, void* m) {
+  //validate data before treating
+  if (validate == 1)
+    validateBI(va);
+
+  //delegate on static function
+  sAccAdd(vc, va, 0, m);
+}
+
+/*
+ * accSub. Use it to subtract a number from an accumulator.
+ */
+void accSub(void* vc, void* va, void* m) {
+  //validate data before treating
+  if (validate == 1)
+    validateBI(va);
+
+  //delegate on static function
+  sAccAdd(vc, va, -1, m);
+}
+
+/*
+ * accMul. Use it to add the product of two numbers to an accumulator.
+ */
+void accMul(void* vc, void* va, void* vb, void* m) {
+  //validate data before treating
+  if (validate == 1) {
+    validateBI(va);
+    validateBI(vb);
+  }
+
+  //delegate on static function
+  sAccMul(vc, va, vb, m);
+}
+
+/*
+ * accDot. Use it to add the dot product of two arrays of n numbers to an accumulator.
+ */
+void accDot(void* vc, void* va, void* vb, int n, void* m) {
+  int i = 0;
+
+  //validate data before treating
+  if (validate == 1)
+    for (; i < n; i++) {
+      validateBI((BigInteger*)va + i);
+      validateBI((BigInteger*)vb + i);
+    }
+
+  //delegate on static function
+  sAccDot(vc, va, vb, n, m);
+}
+
+/*
+ * accGet. Use it to get the value of an accumulator (it keeps adding afterwards).
+ */
+void accGet(void* va, void* vc, void* m) {
+  //delegate on static function
+  sAccGet(va, vc, m);
+}
+
+/*
+ * getStrLen. Returns the characters toString writes (sign included, '\0' excluded)
+ */
+int getStrLen(void* va) {
+  return ((BigInteger*)va)->count + 1 + (((BigInteger*)va)->n[((BigInteger*)va)->count] < 0 ? 1 : 0);
+}
+
+/*
+ * toStringN. As toString, but dst has room for "size" characters ('\0' included). Returns the
+ * characters of the number (as getStrLen); if they don't fit, dst only gets '\0'
+ */
+int toStringN(void* vb, char* dst, int size) {
+  int len = getStrLen(vb);
+
+  if (len >= size) {
+    if (size > 0)
+      dst[0] = '\0';
+
+    return len;
+  }
+
+  toString(vb, dst);
+
+  return len;
 }
 
 /*
@@ -2548,55 +3806,60 @@ void equals(void* va, void* vb, int* ret) {
 
 /*
  * iniStr. Allocates memory for a BigInteger string, to be used on toString function
+ * (MAX_LENGTH digits, the sign and '\0')
  */
 void iniStr(char** dst) {
-  *dst = (char*)malloc(sizeof(char) * MAX_LENGTH);
+  *dst = (char*)malloc(sizeof(char) * (MAX_LENGTH + 2));
 }
 
 /*
  * init. Starts BigInteger engine.
  */
 void init(void** m) {
+  int i = 0;
+
   //add
   ((memory*)m)->vt = malloc(sizeof(BigInteger));
 
   //subtract
   ((memory*)m)->stmp = malloc(sizeof(BigInteger));
 
-  //multiplication
-  ((memory*)m)->mpart = malloc(sizeof(BigInteger));
-  ((memory*)m)->mret = malloc(sizeof(BigInteger));
-  ((memory*)m)->mzero = malloc(sizeof(BigInteger));
-  ((memory*)m)->mone = malloc(sizeof(BigInteger));
-  ((memory*)m)->mtmp = malloc(sizeof(BigInteger));
-
   //division
-  ((memory*)m)->done = malloc(sizeof(BigInteger));
-  ((memory*)m)->dtmp = malloc(sizeof(BigInteger));
-  ((memory*)m)->dret = malloc(sizeof(BigInteger));
   ((memory*)m)->dTemp = malloc(sizeof(BigInteger));
-  ((memory*)m)->biTemp = malloc(sizeof(BigInteger));
 
   //root
-  ((memory*)m)->sret = malloc(sizeof(BigInteger));
-  ((memory*)m)->sraw = malloc(sizeof(BigInteger));
-  ((memory*)m)->sbase = malloc(sizeof(BigInteger));
-  ((memory*)m)->szero = malloc(sizeof(BigInteger));
+  ((memory*)m)->lsscr = malloc(sizeof(BLlimb) * lRootScratch(L_MAX_LENGTH));
 
   //power
   ((memory*)m)->bres = malloc(sizeof(BigInteger));
-  ((memory*)m)->btmp = malloc(sizeof(BigInteger));
+  ((memory*)m)->btmp = malloc(sizeof(BigInteger) * (1 << (BIPOW_WINDOW - 1)));
 
-  //append
-  ((memory*)m)->aaux = malloc(sizeof(BigInteger));
+  //limb engine
+  ((memory*)m)->la = malloc(sizeof(BLlimb) * L_MAX_LENGTH);
+  ((memory*)m)->lb = malloc(sizeof(BLlimb) * L_MAX_LENGTH);
+  ((memory*)m)->lr = malloc(sizeof(BLlimb) * (L_MAX_LENGTH * 2 + 2));
+  ((memory*)m)->lscr = malloc(sizeof(BLlimb) * (lScratch(L_MAX_LENGTH) + 1));
+  ((memory*)m)->ld = malloc(sizeof(BLlimb) * (L_MAX_LENGTH * 2 + 2));
+  ((memory*)m)->ldscr = malloc(sizeof(BLlimb) * lDivScratch(L_MAX_LENGTH * 2 + 2, L_MAX_LENGTH));
+  ((memory*)m)->lmscr = malloc(sizeof(BLlimb) * (lMontScratch(L_MAX_LENGTH, L_MAX_LENGTH) + lBarrettScratch(L_MAX_LENGTH, 0)));
+  ((memory*)m)->lgscr = malloc(sizeof(BLlimb) * lGcdScratch(L_MAX_LENGTH));
+  ((memory*)m)->lpscr = malloc(sizeof(BLlimb) * lPrimeScratch(L_MAX_LENGTH));
 
-  //BIT
-  ((memory*)m)->biBIT = malloc(sizeof(BIT));
+  //decimal point
+  ((memory*)m)->point = 0;
 
-  //common values
-  _BI_initialize();
+  //multiplication threads
+  ((memory*)m)->threads = MUL_THREADS;
 
   BImemcpy(((memory*)m)->vt, 2);
+
+  //working values start as 0, so BIcopy and BIzero only clear their used digits
+  BImemcpy(((memory*)m)->stmp, 0);
+  BImemcpy(((memory*)m)->dTemp, 0);
+  BImemcpy(((memory*)m)->bres, 0);
+
+  for (; i < (1 << (BIPOW_WINDOW - 1)); i++)
+    BImemcpy((BigInteger*)((memory*)m)->btmp + i, 0);
 }
 
 /*
@@ -2606,6 +3869,34 @@ size_t getMemorySize() {
   return sizeof(memory);
 }
 
+/*
+ * getMontSize. Returns Montgomery context size
+ */
+size_t getMontSize() {
+  return sizeof(BLmont);
+}
+
+/*
+ * getBarrettSize. Returns Barrett context size
+ */
+size_t getBarrettSize() {
+  return sizeof(BLbarrett);
+}
+
+/*
+ * getAccSize. Returns accumulator size
+ */
+size_t getAccSize() {
+  return sizeof(BLacc);
+}
+
+/*
+ * getBITSize. Returns BIT size
+ */
+size_t getBITSize() {
+  return sizeof(BIT);
+}
+
 /*
  * clean. Cleans a BigInteger, moving 0 as value
  */
@@ -2649,6 +3940,14 @@ __host__ __device__
     printf("Error. Puntero erróneo en sub");
   else if (k == 11)
     printf("Error. Puntero erróneo en add");
+  else if (k == 13)
+    printf("Error. Módulo o puntero erróneo en aritmética modular");
+  else if (k == 52)
+    printf("Error. Copia errónea en h2d");
+  else if (k == 53)
+    printf("Error. Copia errónea en d2h");
+  else if (k == 54)
+    printf("Error. Lanzamiento erróneo en CUlaunch");
   else if (k == 98)
     printf("Error. Puntero erróneo en validateBI");
   else if (k == 99)
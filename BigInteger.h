@@ -7,6 +7,8 @@
 #ifndef BIGINTEGER_H_
 #define BIGINTEGER_H_
 
+#include "BigLimb.h"
+
 //MAX_LENGTH: Global varialbe to set BigInteger length.
 static int MAX_LENGTH =
 #ifdef C_MAX_LENGTH
@@ -15,6 +17,16 @@ C_MAX_LENGTH;
 4096;
 #endif
 
+//MUL_THREADS: threads used by default on a single big multiplication (see setThreads)
+#ifdef C_MUL_THREADS
+#define MUL_THREADS C_MUL_THREADS
+#else
+#define MUL_THREADS 1
+#endif
+
+//BIPOW_WINDOW: maximum sliding window (bits) on bipow. btmp holds 2^(BIPOW_WINDOW - 1) odd powers
+#define BIPOW_WINDOW 3
+
 /*****************************************************************************
  *                                 Structures                                *
  *****************************************************************************/
@@ -31,10 +43,13 @@ typedef struct BigInteger {
   ];
 } BigInteger;
 
-//BIT, multiplication and division buffer
+//BIT, operand pinned for multiplication and division (see bitInit). "src" keeps the digits it was
+//built from, "l" the packed operand (nb limbs) and "d" its divisor context
 typedef struct BIT {
-  BigInteger BI[10];
-  int status[10];
+  BigInteger src;
+  int nb;
+  BLlimb l[L_MAX_LENGTH];
+  BLdiv d;
 } BIT;
 
 //Working variables
@@ -47,76 +62,118 @@ typedef struct memory {
   void* stmp;
 
   //mul
-  void* mpart;
-  void* mret;
-  void* mzero;
-  void* mone;
-  void* mtmp;
+  int threads;
 
   //dvs
-  void* done;
-  void* dtmp;
-  void* dret;
+  int point;
   void* dTemp;
-  void* biTemp;
 
   //nqrt
-  void* sret;
-  void* sraw;
-  void* sbase;
-  void* szero;
+  void* lsscr;
 
   //bipow
   void* bres;
   void* btmp;
 
-  //append
-  void* aaux;
-
-  //BIT
-  void* biBIT;
+  //limb engine
+  void* la;
+  void* lb;
+  void* lr;
+  void* lscr;
+  void* ld;
+  void* ldscr;
+  void* lmscr;
+  void* lgscr;
+  void* lpscr;
 } memory;
 #endif
 
 /*****************************************************************************
  *                              Useful variables                             *
  *****************************************************************************/
-//Quick values ({0..10, 100, -1})
-static BigInteger _ZERO;
-static BigInteger _ONE;
-static BigInteger _TWO;
-static BigInteger _THREE;
-static BigInteger _FOUR;
-static BigInteger _FIVE;
-static BigInteger _SIX;
-static BigInteger _SEVEN;
-static BigInteger _EIGHT;
-static BigInteger _NINE;
-static BigInteger _TEN;
-static BigInteger _HUND;
-static BigInteger _MIN;
-
-//Decimal point when using BOperation
-static int BI_point;
-
-//Status code
-static int BIReturnCode;
+//Quick values ({0..10, 100, -1}). They are built at compile time and never written, so
+//they can be shared between threads
+static const BigInteger _ZERO = { 'i', 0, { 0 } };
+static const BigInteger _ONE = { 'i', 0, { 1 } };
+static const BigInteger _TWO = { 'i', 0, { 2 } };
+static const BigInteger _THREE = { 'i', 0, { 3 } };
+static const BigInteger _FOUR = { 'i', 0, { 4 } };
+static const BigInteger _FIVE = { 'i', 0, { 5 } };
+static const BigInteger _SIX = { 'i', 0, { 6 } };
+static const BigInteger _SEVEN = { 'i', 0, { 7 } };
+static const BigInteger _EIGHT = { 'i', 0, { 8 } };
+static const BigInteger _NINE = { 'i', 0, { 9 } };
+static const BigInteger _TEN = { 'i', 1, { 0, 1 } };
+static const BigInteger _HUND = { 'i', 2, { 0, 0, 1 } };
+static const BigInteger _MIN = { 'i', 0, { -1 } };
+
+//BI_TLS: thread local storage
+#if defined(_MSC_VER)
+#define BI_TLS __declspec(thread)
+#elif defined(__GNUC__)
+#define BI_TLS __thread
+#else
+#define BI_TLS _Thread_local
+#endif
+
+//Status code. Every thread keeps its own (as errno), as newBI or validateBI have no memory
+static BI_TLS int BIReturnCode;
 
 #if CUDA_ENABLED == 1
 __device__ static int cBIReturnCode;
 #endif
 
+//CUDA_ENABLED 2: the CU* kernels are built for the host (no GPU). CUDA qualifiers are dropped and
+//kernels run on host threads through CUlaunch, that fills threadIdx, blockIdx, blockDim and gridDim
+//(x only) for every emulated thread
+#if CUDA_ENABLED == 2
+#define __host__
+#define __device__
+#define __global__
+
+typedef struct CUdim {
+  unsigned int x;
+  unsigned int y;
+  unsigned int z;
+} CUdim;
+
+extern BI_TLS CUdim threadIdx;
+extern BI_TLS CUdim blockIdx;
+extern BI_TLS CUdim blockDim;
+extern BI_TLS CUdim gridDim;
+
+//CU_THREADS: host threads used by CUlaunch (0 = one per CPU)
+#ifdef C_CU_THREADS
+#define CU_THREADS C_CU_THREADS
+#else
+#define CU_THREADS 0
+#endif
+
+//CU_LAUNCH: launches kernel k (with a single pointer as argument) on a 1D grid, and waits for it
+#define CU_LAUNCH(k, blocks, threads, arg) CUlaunch(k, blocks, threads, arg)
+#elif CUDA_ENABLED == 1
+#define CU_LAUNCH(k, blocks, threads, arg) (k<<<blocks, threads>>>(arg), cudaDeviceSynchronize())
+#endif
+
 /*****************************************************************************
  *                            Function definition                            *
  *****************************************************************************/
  //CUDA specific
-#if CUDA_ENABLED == 1
+#if CUDA_ENABLED == 1 || CUDA_ENABLED == 2
  //h2d
 void h2d(void** device, void* host, int quantity, size_t size);
 
 //d2h
 void d2h(void* host, void* device, int quantity, size_t size);
 
+//dFree
+void dFree(void* device);
+
+#if CUDA_ENABLED == 2
+//CUlaunch
+int CUlaunch(void (*k)(void*), int blocks, int threads, void* arg);
+#endif
+
 //CUnewBI
 __device__ void CUnewBI(void* dst, char* s, int sig);
 
@@ -178,11 +235,23 @@ __device__ void CUsqrt(void* va, void* vb, void* vc, void* vd);
 //newBI
 void newBI(void* dst, const char* s, int sig);
 
+//newBIN
+void newBIN(void* dst, const char* s, int len, int sig);
+
 //validateBI
 void validateBI(void* a);
 
+//BI2BL
+void BI2BL(void* dst, void* src);
+
+//BL2BI
+void BL2BI(void* dst, void* src);
+
 //getPoint
-int getPoint();
+int getPoint(void* m);
+
+//setThreads
+void setThreads(void* m, int n);
 
 //getReturnCode
 int getReturnCode();
@@ -190,17 +259,29 @@ int getReturnCode();
 //setReturnCode
 void setReturnCode(int k);
 
-//_BI_initialize
-#if BI_STANDALONE == 1 
+//BImemcpy
+void BImemcpy(void* dst, int orig);
+
+//BIcopy
+#if BI_STANDALONE == 1
 static
 #endif
- void _BI_initialize();
+ void BIcopy(void* dst, void* src);
 
-//BImemcpy
-void BImemcpy(void* dst, int orig);
+//BIzero
+#if BI_STANDALONE == 1
+static
+#endif
+ void BIzero(void* dst);
+
+//lPack
+static int lPack(BLlimb* dst, void* va);
 
-//pAppend
-static void pAppend(void* va, int b);
+//lPackShift
+static int lPackShift(BLlimb* dst, void* va, int s);
+
+//lUnpack
+static int lUnpack(void* va, BLlimb* src, int n);
 
 //signum
 static int signum(int a, int b);
@@ -220,12 +301,6 @@ static
 //addition
 static void addition(void* va, void* vb);
 
-//carryAdd
-#if BI_STANDALONE == 1
-static
-#endif
- void carryAdd(void* va, int move, int min);
-
 //pSub
 #if BI_STANDALONE == 1
 static
@@ -247,8 +322,11 @@ static
 #endif
  void sMul(void* va, void* vb, void* m);
 
-//pMul
-static void pMul(int pos, void* vpart);
+//sSqr
+#if BI_STANDALONE == 1
+static
+#endif
+ void sSqr(void* va, void* m);
 
 //sDvs
 #if BI_STANDALONE == 1
@@ -256,6 +334,135 @@ static
 #endif
  void sDvs(void* va, void* vb, void* m);
 
+//sDivmod
+#if BI_STANDALONE == 1
+static
+#endif
+ void sDivmod(void* vq, void* vr, void* va, void* vb, void* m);
+
+//sBarrettInit
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBarrettInit(void* vc, void* vn, void* m);
+
+//sBmod
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBmod(void* va, void* vc, void* m);
+
+//sMontInit
+#if BI_STANDALONE == 1
+static
+#endif
+ void sMontInit(void* vc, void* vn, void* m);
+
+//lModLoad
+static void lModLoad(BLlimb* r, void* va, void* vc, void* m);
+
+//lModStore
+static void lModStore(void* va, BLlimb* r, void* vc, void* m);
+
+//sModmul
+#if BI_STANDALONE == 1
+static
+#endif
+ void sModmul(void* va, void* vb, void* vc, void* m);
+
+//sModsqr
+#if BI_STANDALONE == 1
+static
+#endif
+ void sModsqr(void* va, void* vc, void* m);
+
+//sModpow
+#if BI_STANDALONE == 1
+static
+#endif
+ void sModpow(void* va, void* ve, void* vc, void* m);
+
+//sGcd
+#if BI_STANDALONE == 1
+static
+#endif
+ void sGcd(void* va, void* vb, void* m);
+
+//sXgcd
+#if BI_STANDALONE == 1
+static
+#endif
+ void sXgcd(void* vg, void* vx, void* vy, void* va, void* vb, void* m);
+
+//sModinv
+#if BI_STANDALONE == 1
+static
+#endif
+ void sModinv(void* va, void* vn, void* m);
+
+//sIsPrime
+#if BI_STANDALONE == 1
+static
+#endif
+ int sIsPrime(void* va, int rounds, void* m);
+
+//sPrimeSieve
+#if BI_STANDALONE == 1
+static
+#endif
+ int sPrimeSieve(void* va, int len, char* res, int rounds, void* m);
+
+//sAccAdd
+#if BI_STANDALONE == 1
+static
+#endif
+ void sAccAdd(void* vc, void* va, int sig, void* m);
+
+//sAccMul
+#if BI_STANDALONE == 1
+static
+#endif
+ void sAccMul(void* vc, void* va, void* vb, void* m);
+
+//sAccDot
+#if BI_STANDALONE == 1
+static
+#endif
+ void sAccDot(void* vc, void* va, void* vb, int n, void* m);
+
+//sAccGet
+#if BI_STANDALONE == 1
+static
+#endif
+ void sAccGet(void* va, void* vc, void* m);
+
+//bitLoad
+static int bitLoad(void* vt, void* vb, void* m);
+
+//sBitInit
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBitInit(void* vt, void* vb, void* m);
+
+//sBitMul
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBitMul(void* va, void* vb, void* vt, void* m);
+
+//sBitDvs
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBitDvs(void* va, void* vb, void* vt, void* m);
+
+//sBitDivmod
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBitDivmod(void* vq, void* vr, void* va, void* vb, void* vt, void* m);
+
 //divide
 static void divide(void* va, void* vb, void* m);
 
@@ -271,6 +478,12 @@ static
 #endif
  void sBipow(void* va, int p, void* m);
 
+//sBipowBI
+#if BI_STANDALONE == 1
+static
+#endif
+ void sBipowBI(void* va, void* ve, void* m);
+
 //Standalone definitions
 #if BI_STANDALONE == 1
 //add
@@ -291,12 +504,87 @@ void nqrt(void* va, int n, void* m);
 //bipow
 void bipow(void* va, int p, void* m);
 
+//bipowBI
+void bipowBI(void* va, void* ve, void* m);
+
 //mod
 void mod(void* va, void* vb, void* m);
 
+//divmod
+void divmod(void* vq, void* vr, void* va, void* vb, void* m);
+
+//barrettInit
+void barrettInit(void* vc, void* vn, void* m);
+
+//bmod
+void bmod(void* va, void* vc, void* m);
+
+//montInit
+void montInit(void* vc, void* vn, void* m);
+
+//modmul
+void modmul(void* va, void* vb, void* vc, void* m);
+
+//modsqr
+void modsqr(void* va, void* vc, void* m);
+
+//modpow
+void modpow(void* va, void* ve, void* vc, void* m);
+
+//gcd
+void gcd(void* va, void* vb, void* m);
+
+//xgcd
+void xgcd(void* vg, void* vx, void* vy, void* va, void* vb, void* m);
+
+//modinv
+void modinv(void* va, void* vn, void* m);
+
+//isProbablePrime
+int isProbablePrime(void* va, int rounds, void* m);
+
+//primeSieve
+int primeSieve(void* va, int len, char* res, int rounds, void* m);
+
+//bitInit
+void bitInit(void* vt, void* vb, void* m);
+
+//bitMul
+void bitMul(void* va, void* vb, void* vt, void* m);
+
+//bitDvs
+void bitDvs(void* va, void* vb, void* vt, void* m);
+
+//bitDivmod
+void bitDivmod(void* vq, void* vr, void* va, void* vb, void* vt, void* m);
+
+//accInit
+void accInit(void* vc);
+
+//accAdd
+void accAdd(void* vc, void* va, void* m);
+
+//accSub
+void accSub(void* vc, void* va, void* m);
+
+//accMul
+void accMul(void* vc, void* va, void* vb, void* m);
+
+//accDot
+void accDot(void* vc, void* va, void* vb, int n, void* m);
+
+//accGet
+void accGet(void* va, void* vc, void* m);
+
 //toString
 void toString(void* vb, char* dst);
 
+//toStringN
+int toStringN(void* vb, char* dst, int size);
+
+//getStrLen
+int getStrLen(void* va);
+
 //equals
 void equals(void* va, void* vb, int* ret);
 
@@ -309,6 +597,18 @@ void init(void** m);
 //getMemorySize 
 size_t getMemorySize();
 
+//getMontSize
+size_t getMontSize();
+
+//getBarrettSize
+size_t getBarrettSize();
+
+//getAccSize
+size_t getAccSize();
+
+//getBITSize
+size_t getBITSize();
+
 //clean
 void clean(void* va);
 
@@ -0,0 +1,3879 @@
+/*
+ * BigLimb.c
+ *
+ *  Created on: 17 oct. 2026
+ *    Author: DoHITB under MIT License
+ *
+ *  Limb engine for BigInteger. Numbers are stored on base 10^9 limbs (BL_BASE), so a single
+ *  32-bit word holds 9 decimal digits and the conversion from/to BigInteger digits is linear.
+ *
+ *  Low level functions ("l" prefix) work over raw limb arrays, least significant limb first,
+ *  and are the ones used by BigInteger to perform the heavy operations.
+ *
+ *  CHANGELOG
+ *  v1.0
+ *    - Limb kernels: add-with-carry (lAdc), sub-with-borrow (lSbb) and multiply-accumulate (lMac).
+ *    - Schoolbook multiplication (lMul).
+ *    - BigLimb structure and its basic operations (BLadd, BLsub, BLmul, BLequals).
+ *  v1.1
+ *    - Size-dispatched multiplication: schoolbook, Karatsuba and Toom-3 (lMul).
+ *    - New kernels: multiply-subtract (lMsb) and single limb division (lDiv1).
+ *    - Thresholds can be tuned with C_KARA_THRESHOLD and C_TOOM_THRESHOLD.
+ *  v1.2
+ *    - Number-theoretic transform multiplication (three primes + CRT) for big operands.
+ *    - Threshold can be tuned with C_NTT_THRESHOLD.
+ *  v1.3
+ *    - Squaring (lSqr). lMul detects a == b and every tier takes profit of the symmetry.
+ *    - Threshold can be tuned with C_KARA_SQR_THRESHOLD.
+ *  v1.4
+ *    - Division (lDivRem): schoolbook (Knuth D) and Newton reciprocal with Barrett windows.
+ *    - Threshold can be tuned with C_DIV_NEWTON_THRESHOLD.
+ *  v1.5
+ *    - Montgomery context (BLmont): modular multiplication and sliding window exponentiation.
+ *    - Moduli not coprime with 10 fall back to reduction by division.
+ *  v1.6
+ *    - Barrett context (BLbarrett): reduction by a fixed modulus with two multiplications.
+ *  v1.7
+ *    - Integer n-th root (lRoot) with Newton's iteration. Square roots don't need any power.
+ *  v1.8
+ *    - Parallel multiplication (lMulThreads): Karatsuba branches on their own threads.
+ *    - Threshold can be tuned with C_MUL_THREAD_THRESHOLD.
+ *  v1.9
+ *    - GCD (lGcd), extended GCD (lXgcd) and modular inverse (lModInv): Lehmer steps over two limb
+ *      approximations, ending with binary GCD on a word.
+ *  v1.10
+ *    - Primality (lIsPrime): trial division by the primes below 2048, and Baillie-PSW (Miller-Rabin
+ *      to base 2 and strong Lucas test) over the Montgomery context.
+ *    - Range sieve (lPrimeSieve): the range is sieved with the primes up to 2^22, and only the
+ *      survivors are tested.
+ *  v1.11
+ *    - Decimal digit kernels (lDigitAdd, lDigitSub) for BigInteger add and subtract: SSE2, AVX2 and
+ *      AVX-512BW blocks with carry lookahead (every digit is normalized once), chosen through CPUID
+ *      (lCpu, lDigitSimd). Scalar references are kept (lDigitAddScalar, lDigitSubScalar).
+ *    - The widest level can be limited with C_BL_SIMD.
+ *  v1.12
+ *    - Accumulator (BLacc): signed 64-bit limb lanes that take numbers (lAccAdd) and products
+ *      (lAccMul), and 32-bit digit lanes that take BigInteger digits with no packing (lAccDigits,
+ *      with SSE2, AVX2 and AVX-512 kernels). Carries are propagated once (lAccNorm, lAccGet).
+ *    - Threshold can be tuned with C_ACC_MUL_THRESHOLD.
+ *  v1.13
+ *    - Divisor context (BLdiv): the normalized divisor and its reciprocal are made once (lDivInit)
+ *      and reused on every division by it (lDivPre).
+ *  v1.14
+ *    - The digit kernels are chosen once, on the first use (pthread_once or InitOnceExecuteOnce),
+ *      so init doesn't write lDigitLevel while other threads add or subtract. lDigitSimd only
+ *      returns the level.
+ */
+#include "stdlib.h"
+#include "string.h"
+#include "BigLimb.h"
+
+//vector digit kernels on x86 (GCC, Clang and MSVC)
+#if (defined(__GNUC__) || defined(_MSC_VER)) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define BL_X86 1
+#include "immintrin.h"
+#if defined(_MSC_VER)
+#include "intrin.h"
+#define BL_SSE2_FN
+#define BL_AVX2_FN
+#define BL_AVX512_FN
+#else
+#define BL_SSE2_FN __attribute__((target("sse2")))
+#define BL_AVX2_FN __attribute__((target("avx2")))
+#define BL_AVX512_FN __attribute__((target("avx512f,avx512bw")))
+#endif
+#endif
+
+//threads for lMulThreads (and the one-time choice of the digit kernels)
+#if defined(_WIN32)
+#include "windows.h"
+#define BL_THREAD_FN DWORD WINAPI
+#define BL_THREAD_START(t, f, a) (((t) = CreateThread(NULL, 0, f, a, 0, NULL)) == NULL)
+#define BL_THREAD_JOIN(t) (WaitForSingleObject(t, INFINITE), CloseHandle(t))
+#define BL_ONCE_FN(f) BOOL CALLBACK f(PINIT_ONCE o, PVOID p, PVOID* c)
+#define BL_ONCE_END return TRUE
+#define BL_ONCE(o, f) InitOnceExecuteOnce(&(o), f, NULL, NULL)
+#define BL_ONCE_INIT INIT_ONCE_STATIC_INIT
+typedef HANDLE BLthread;
+typedef INIT_ONCE BLonce;
+#else
+#include "pthread.h"
+#define BL_THREAD_FN void*
+#define BL_THREAD_START(t, f, a) pthread_create(&(t), NULL, f, a)
+#define BL_THREAD_JOIN(t) pthread_join(t, NULL)
+#define BL_ONCE_FN(f) void f()
+#define BL_ONCE_END return
+#define BL_ONCE(o, f) pthread_once(&(o), f)
+#define BL_ONCE_INIT PTHREAD_ONCE_INIT
+typedef pthread_t BLthread;
+typedef pthread_once_t BLonce;
+#endif
+
+//KARA_THRESHOLD: limbs from which Karatsuba is used
+#ifdef C_KARA_THRESHOLD
+#define KARA_THRESHOLD C_KARA_THRESHOLD
+#else
+#define KARA_THRESHOLD 24
+#endif
+
+//TOOM_THRESHOLD: limbs from which Toom-3 is used
+#ifdef C_TOOM_THRESHOLD
+#define TOOM_THRESHOLD C_TOOM_THRESHOLD
+#else
+#define TOOM_THRESHOLD 192
+#endif
+
+//KARA_SQR_THRESHOLD: limbs from which Karatsuba is used on squaring
+#ifdef C_KARA_SQR_THRESHOLD
+#define KARA_SQR_THRESHOLD C_KARA_SQR_THRESHOLD
+#else
+#define KARA_SQR_THRESHOLD 48
+#endif
+
+//NTT_THRESHOLD: limbs from which the number-theoretic transform is used
+#ifdef C_NTT_THRESHOLD
+#define NTT_THRESHOLD C_NTT_THRESHOLD
+#else
+#define NTT_THRESHOLD 896
+#endif
+
+//MUL_THREAD_THRESHOLD: limbs from which lMulThreads splits the product between threads
+#ifdef C_MUL_THREAD_THRESHOLD
+#define MUL_THREAD_THRESHOLD C_MUL_THREAD_THRESHOLD
+#else
+#define MUL_THREAD_THRESHOLD 256
+#endif
+
+//DIV_NEWTON_THRESHOLD: divisor limbs from which division is made with a Newton reciprocal
+#ifdef C_DIV_NEWTON_THRESHOLD
+#define DIV_NEWTON_THRESHOLD C_DIV_NEWTON_THRESHOLD
+#else
+#define DIV_NEWTON_THRESHOLD 96
+#endif
+
+//ACC_MUL_THRESHOLD: limbs from which lAccMul multiplies with lMul instead of adding the partial products
+#ifdef C_ACC_MUL_THRESHOLD
+#define ACC_MUL_THRESHOLD C_ACC_MUL_THRESHOLD
+#else
+#define ACC_MUL_THRESHOLD KARA_THRESHOLD
+#endif
+
+//MONT_WINDOW: maximum sliding window (bits) on modular exponentiation
+#define MONT_WINDOW 6
+
+//BL_BITS: bits per word when an exponent is moved to binary (2^BL_BITS < BL_BASE)
+#define BL_BITS 29
+
+//NTT primes (c * 2^k + 1, all of them with 3 as primitive root)
+#define NTT_P1 998244353u
+#define NTT_P2 167772161u
+#define NTT_P3 469762049u
+#define NTT_G 3u
+
+//NTT_MAX: maximum transform length (2^23 is the smallest 2-adic order among the three primes)
+#define NTT_MAX (1 << 23)
+
+//BL_PRIMES: odd primes on the trial division table (lPrimes)
+#define BL_PRIMES 308
+
+//BL_SIEVE_MAX: sieving bound on lPrimeSieve (below 2053^2, so the table sieves the primes up to it)
+#define BL_SIEVE_MAX (1 << 22)
+
+//BL_SIEVE_SEGMENT: odd numbers on every segment when the primes up to BL_SIEVE_MAX are sieved
+#define BL_SIEVE_SEGMENT 4096
+
+//BL_MONT_LIMBS: limbs taken by a Montgomery context placed on a working buffer
+#define BL_MONT_LIMBS ((int)((sizeof(BLmont) + sizeof(BLlimb) - 1) / sizeof(BLlimb)))
+
+//digit kernels in use, chosen once with BL_SIMD (see lDigitLevelGet)
+static int lDigitLevel = BL_SCALAR;
+static BLonce lDigitOnce = BL_ONCE_INIT;
+
+static int lDigitLevelGet();
+
+/*
+ * lAdc.
+ *
+ * Performs r = a + b + c over n limbs. Returns the carry.
+ */
+BLlimb lAdc(BLlimb* r, BLlimb* a, BLlimb* b, int n, BLlimb c) {
+  int i = 0;
+  BLlimb s;
+
+  for (; i < n; i++) {
+    s = a[i] + b[i] + c;
+
+    //as limbs are below 10^9, the sum never overflows the 32-bit word
+    c = (s >= BL_BASE);
+
+    if (c == 1)
+      s -= BL_BASE;
+
+    r[i] = s;
+  }
+
+  return c;
+}
+
+/*
+ * lSbb.
+ *
+ * Performs r = a - b - c over n limbs. Returns the borrow.
+ */
+BLlimb lSbb(BLlimb* r, BLlimb* a, BLlimb* b, int n, BLlimb c) {
+  int i = 0;
+  BLlimb s;
+
+  for (; i < n; i++) {
+    s = b[i] + c;
+
+    if (a[i] < s) {
+      r[i] = a[i] + BL_BASE - s;
+      c = 1;
+    } else {
+      r[i] = a[i] - s;
+      c = 0;
+    }
+  }
+
+  return c;
+}
+
+/*
+ * lAdd1.
+ *
+ * Performs r = a + c over n limbs. Returns the carry.
+ */
+BLlimb lAdd1(BLlimb* r, BLlimb* a, int n, BLlimb c) {
+  int i = 0;
+  BLlimb s;
+
+  for (; i < n; i++) {
+    s = a[i] + c;
+
+    c = (s >= BL_BASE);
+
+    if (c == 1)
+      s -= BL_BASE;
+
+    r[i] = s;
+  }
+
+  return c;
+}
+
+/*
+ * lSub1.
+ *
+ * Performs r = a - c over n limbs. Returns the borrow.
+ */
+BLlimb lSub1(BLlimb* r, BLlimb* a, int n, BLlimb c) {
+  int i = 0;
+
+  for (; i < n; i++) {
+    if (a[i] < c) {
+      r[i] = a[i] + BL_BASE - c;
+      c = 1;
+    } else {
+      r[i] = a[i] - c;
+      c = 0;
+    }
+  }
+
+  return c;
+}
+
+/*
+ * lMac.
+ *
+ * Performs r += a * k over n limbs. Returns the carry limb (to be stored on r[n]).
+ */
+BLlimb lMac(BLlimb* r, BLlimb* a, int n, BLlimb k) {
+  int i = 0;
+  BLdlimb t;
+  BLlimb c = 0;
+
+  if (k == 0)
+    return 0;
+
+  for (; i < n; i++) {
+    //(10^9 - 1)^2 + 2 * (10^9 - 1) still fits on 64 bits
+    t = (BLdlimb)a[i] * k + r[i] + c;
+
+    c = (BLlimb)(t / BL_BASE);
+    r[i] = (BLlimb)(t - (BLdlimb)c * BL_BASE);
+  }
+
+  return c;
+}
+
+/*
+ * lMsb.
+ *
+ * Performs r -= a * k over n limbs. Returns the borrow limb (to be subtracted from r[n]).
+ */
+BLlimb lMsb(BLlimb* r, BLlimb* a, int n, BLlimb k) {
+  int i = 0;
+  BLdlimb t;
+  BLlimb c = 0;
+  BLlimb l;
+
+  if (k == 0)
+    return 0;
+
+  for (; i < n; i++) {
+    t = (BLdlimb)a[i] * k + c;
+
+    c = (BLlimb)(t / BL_BASE);
+    l = (BLlimb)(t - (BLdlimb)c * BL_BASE);
+
+    if (r[i] < l) {
+      r[i] = r[i] + BL_BASE - l;
+      ++c;
+    } else
+      r[i] -= l;
+  }
+
+  return c;
+}
+
+/*
+ * lDiv1.
+ *
+ * Performs r = a / d over n limbs (d < BL_BASE). Returns the remainder.
+ */
+BLlimb lDiv1(BLlimb* r, BLlimb* a, int n, BLlimb d) {
+  int i = n - 1;
+  BLdlimb t;
+  BLlimb c = 0;
+
+  for (; i >= 0; i--) {
+    t = (BLdlimb)c * BL_BASE + a[i];
+
+    r[i] = (BLlimb)(t / d);
+    c = (BLlimb)(t - (BLdlimb)r[i] * d);
+  }
+
+  return c;
+}
+
+/*
+ * lCmp.
+ *
+ * Compares two magnitudes.
+ *   Return 0 if a = b
+ *   Return 1 if a > b
+ *   Return 2 if a < b
+ */
+int lCmp(BLlimb* a, int na, BLlimb* b, int nb) {
+  int i;
+
+  na = lLen(a, na);
+  nb = lLen(b, nb);
+
+  if (na != nb)
+    return na > nb ? 1 : 2;
+
+  for (i = na - 1; i >= 0; i--)
+    if (a[i] != b[i])
+      return a[i] > b[i] ? 1 : 2;
+
+  return 0;
+}
+
+/*
+ * lLen.
+ *
+ * Returns the number of significant limbs (0 if the number is 0)
+ */
+int lLen(BLlimb* a, int n) {
+  while (n > 0 && a[n - 1] == 0)
+    --n;
+
+  return n;
+}
+
+/*
+ * lMulBasecase.
+ *
+ * Schoolbook multiplication. r = a * b, r has na + nb limbs and cannot overlap a or b.
+ */
+static void lMulBasecase(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb) {
+  int j = 0;
+
+  memset(r, 0, sizeof(BLlimb) * (na + nb));
+
+  for (; j < nb; j++)
+    r[na + j] = lMac(r + j, a, na, b[j]);
+}
+
+/*
+ * lSqrBasecase.
+ *
+ * Schoolbook squaring. Cross products are calculated once and doubled, so it makes
+ * about half of the products of lMulBasecase. r has 2n limbs and cannot overlap a.
+ */
+static void lSqrBasecase(BLlimb* r, BLlimb* a, int n) {
+  int i = 0;
+  BLdlimb t;
+  BLlimb c = 0;
+
+  memset(r, 0, sizeof(BLlimb) * 2 * n);
+
+  //a[i] * a[j], j > i
+  for (; i < n - 1; i++)
+    r[i + n] = lMac(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+
+  //double them
+  lAdc(r, r, r, 2 * n, 0);
+
+  //add the diagonal a[i]^2
+  for (i = 0; i < n; i++) {
+    t = (BLdlimb)a[i] * a[i] + r[2 * i] + c;
+    r[2 * i] = (BLlimb)(t % BL_BASE);
+
+    t = t / BL_BASE + r[2 * i + 1];
+    r[2 * i + 1] = (BLlimb)(t % BL_BASE);
+    c = (BLlimb)(t / BL_BASE);
+  }
+}
+
+/*
+ * lAddTo.
+ *
+ * Performs r += a, being na <= nr. Returns the carry.
+ */
+static BLlimb lAddTo(BLlimb* r, int nr, BLlimb* a, int na) {
+  BLlimb c = lAdc(r, r, a, na, 0);
+  int i = na;
+
+  //propagate the carry only while needed
+  for (; c > 0 && i < nr; i++) {
+    if (++r[i] == BL_BASE)
+      r[i] = 0;
+    else
+      c = 0;
+  }
+
+  return c;
+}
+
+/*
+ * lSubFrom.
+ *
+ * Performs r -= a, being na <= nr. Returns the borrow.
+ */
+static BLlimb lSubFrom(BLlimb* r, int nr, BLlimb* a, int na) {
+  BLlimb c = lSbb(r, r, a, na, 0);
+  int i = na;
+
+  //propagate the borrow only while needed
+  for (; c > 0 && i < nr; i++) {
+    if (r[i] == 0)
+      r[i] = BL_BASE - 1;
+    else {
+      --r[i];
+      c = 0;
+    }
+  }
+
+  return c;
+}
+
+/*
+ * lMulChunks.
+ *
+ * Performs r = a * b splitting "a" in pieces of "chunk" limbs. Used on unbalanced operands.
+ */
+static void lMulChunks(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, int chunk, BLlimb* scr) {
+  int i = 0;
+  int len;
+  BLlimb* t = scr;
+
+  memset(r, 0, sizeof(BLlimb) * (na + nb));
+
+  for (; i < na; i += chunk) {
+    len = na - i < chunk ? na - i : chunk;
+
+    //partial product, then add it with its offset
+    lMul(t, a + i, len, b, nb, scr + chunk + nb);
+    lAddTo(r + i, na + nb - i, t, lLen(t, len + nb));
+  }
+}
+
+/*
+ * lMulKara.
+ *
+ * Karatsuba multiplication, being na >= nb > ceil(na / 2).
+ *   a * b = z2 * B^2h + ((a0 + a1) * (b0 + b1) - z0 - z2) * B^h + z0
+ */
+static void lMulKara(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  int h = (na + 1) / 2;
+  BLlimb* sa = scr;
+  BLlimb* sb = sa + h + 1;
+  BLlimb* p = sb + h + 1;
+  BLlimb* next = p + 2 * h + 2;
+
+  //sums of both halves (on squaring, both are the same)
+  sa[h] = lAdd1(sa + (na - h), a + (na - h), 2 * h - na, lAdc(sa, a, a + h, na - h, 0));
+
+  if (a == b && na == nb)
+    sb = sa;
+  else
+    sb[h] = lAdd1(sb + (nb - h), b + (nb - h), 2 * h - nb, lAdc(sb, b, b + h, nb - h, 0));
+
+  //z0 and z2 go directly to their place
+  lMul(r, a, h, b, h, next);
+  lMul(r + 2 * h, a + h, na - h, b + h, nb - h, next);
+
+  //middle product
+  lMul(p, sa, h + 1, sb, h + 1, next);
+
+  lSubFrom(p, 2 * h + 2, r, lLen(r, 2 * h));
+  lSubFrom(p, 2 * h + 2, r + 2 * h, lLen(r + 2 * h, na + nb - 2 * h));
+
+  lAddTo(r + h, na + nb - h, p, lLen(p, 2 * h + 2));
+}
+
+/*
+ * lToomEval.
+ *
+ * Evaluates a = a2 * X^2 + a1 * X + a0 (a0, a1 with k limbs, a2 with n2 limbs) on 1, -1 and 2.
+ * Every result has k + 1 limbs. Returns the sign of the value on -1 (1 or -1).
+ */
+static int lToomEval(BLlimb* p1, BLlimb* pm, BLlimb* p2, BLlimb* a, int k, int n2) {
+  int sig = 1;
+  BLlimb c;
+
+  //p1 = a0 + a2 (temporarily)
+  memcpy(p1, a, sizeof(BLlimb) * k);
+  p1[k] = 0;
+  lAddTo(p1, k + 1, a + 2 * k, n2);
+
+  //pm = |a0 + a2 - a1|
+  if (lCmp(p1, k + 1, a + k, k) == 2) {
+    memcpy(pm, a + k, sizeof(BLlimb) * k);
+    pm[k] = 0;
+    lSubFrom(pm, k + 1, p1, k + 1);
+    sig = -1;
+  } else {
+    memcpy(pm, p1, sizeof(BLlimb) * (k + 1));
+    lSubFrom(pm, k + 1, a + k, k);
+  }
+
+  //p1 = a0 + a1 + a2
+  lAddTo(p1, k + 1, a + k, k);
+
+  //p2 = a0 + 2a1 + 4a2
+  memcpy(p2, a, sizeof(BLlimb) * k);
+  p2[k] = 0;
+  p2[k] += lMac(p2, a + k, k, 2);
+
+  c = lMac(p2, a + 2 * k, n2, 4);
+  lAddTo(p2 + n2, k + 1 - n2, &c, 1);
+
+  return sig;
+}
+
+/*
+ * lSubMul.
+ *
+ * Performs r -= a * k, being the result non negative and lLen(a) <= nr.
+ */
+static void lSubMul(BLlimb* r, int nr, BLlimb* a, int na, BLlimb k) {
+  BLlimb c;
+
+  na = lLen(a, na);
+  c = lMsb(r, a, na, k);
+
+  lSubFrom(r + na, nr - na, &c, 1);
+}
+
+/*
+ * lDivExact.
+ *
+ * Exact division of an n limbs number by a small value (2 or 3), in place.
+ */
+static void lDivExact(BLlimb* a, int n, BLlimb d) {
+  lDiv1(a, a, n, d);
+}
+
+/*
+ * lMulToom.
+ *
+ * Toom-3 multiplication, being na >= nb > 2 * ceil(na / 3).
+ * Evaluates on 0, 1, -1, 2 and infinity, and interpolates to get the five coefficients.
+ */
+static void lMulToom(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  int k = (na + 2) / 3;
+  int na2 = na - 2 * k;
+  int nb2 = nb - 2 * k;
+  int nr = na + nb;
+  int sp;
+  int sq;
+  int sm;
+  int len;
+  BLlimb* p1 = scr;
+  BLlimb* pm = p1 + k + 1;
+  BLlimb* p2 = pm + k + 1;
+  BLlimb* q1 = p2 + k + 1;
+  BLlimb* qm = q1 + k + 1;
+  BLlimb* q2 = qm + k + 1;
+  BLlimb* r1 = q2 + k + 1;
+  BLlimb* rm = r1 + 2 * k + 2;
+  BLlimb* r2 = rm + 2 * k + 2;
+  BLlimb* w = r2 + 2 * k + 2;
+  BLlimb* next = w + 2 * k + 3;
+
+  //evaluate on 1, -1 and 2 (on squaring, both are the same)
+  sp = lToomEval(p1, pm, p2, a, k, na2);
+
+  if (a == b && na == nb) {
+    q1 = p1;
+    qm = pm;
+    q2 = p2;
+    sq = sp;
+  } else
+    sq = lToomEval(q1, qm, q2, b, k, nb2);
+
+  //products on 0 and infinity go directly to their place
+  lMul(r, a, k, b, k, next);
+  lMul(r + 4 * k, a + 2 * k, na2, b + 2 * k, nb2, next);
+
+  //products on 1, -1 and 2
+  lMul(r1, p1, k + 1, q1, k + 1, next);
+  lMul(rm, pm, k + 1, qm, k + 1, next);
+  lMul(r2, p2, k + 1, q2, k + 1, next);
+
+  //sign of r(-1)
+  sm = sp * sq;
+  len = 2 * k + 2;
+
+  //w = (r(1) + r(-1)) / 2; r1 = (r(1) - r(-1)) / 2
+  memcpy(w, r1, sizeof(BLlimb) * len);
+  w[len] = 0;
+
+  if (sm == 1) {
+    lAddTo(w, len + 1, rm, len);
+    lSubFrom(r1, len, rm, len);
+  } else {
+    lSubFrom(w, len + 1, rm, len);
+    lAddTo(r1, len, rm, len);
+  }
+
+  lDivExact(w, len + 1, 2);
+  lDivExact(r1, len, 2);
+
+  //c2 = w - c0 - c4 (on w)
+  lSubFrom(w, len + 1, r, lLen(r, 2 * k));
+  lSubFrom(w, len + 1, r + 4 * k, lLen(r + 4 * k, nr - 4 * k));
+
+  //r2 = (r(2) - c0 - 4c2 - 16c4) / 2 = c1 + 4c3
+  lSubFrom(r2, len, r, lLen(r, 2 * k));
+  lSubMul(r2, len, w, len + 1, 4);
+  lSubMul(r2, len, r + 4 * k, nr - 4 * k, 16);
+  lDivExact(r2, len, 2);
+
+  //c3 = (r2 - r1) / 3 (on r2); c1 = r1 - c3 (on r1)
+  lSubFrom(r2, len, r1, len);
+  lDivExact(r2, len, 3);
+  lSubFrom(r1, len, r2, lLen(r2, len));
+
+  //recompose the result
+  memset(r + 2 * k, 0, sizeof(BLlimb) * 2 * k);
+
+  lAddTo(r + k, nr - k, r1, lLen(r1, len));
+  lAddTo(r + 2 * k, nr - 2 * k, w, lLen(w, len + 1));
+  lAddTo(r + 3 * k, nr - 3 * k, r2, lLen(r2, len));
+}
+
+/*
+ * lPowMod.
+ *
+ * Returns b^e mod p, being p a NTT prime.
+ */
+static BLlimb lPowMod(BLlimb b, BLlimb e, BLlimb p) {
+  BLdlimb r = 1;
+  BLdlimb x = b % p;
+
+  for (; e > 0; e >>= 1) {
+    if (e & 1)
+      r = r * x % p;
+
+    x = x * x % p;
+  }
+
+  return (BLlimb)r;
+}
+
+/*
+ * lNttLen.
+ *
+ * Returns the transform length for a product of nr limbs.
+ */
+static int lNttLen(int nr) {
+  int n = 1;
+
+  while (n < nr)
+    n <<= 1;
+
+  return n;
+}
+
+/*
+ * lNttRoots.
+ *
+ * Loads on w the first n / 2 powers of the n-th root of unity modulo p.
+ */
+static void lNttRoots(BLlimb* w, int n, BLlimb p) {
+  BLdlimb g = lPowMod(NTT_G, (p - 1) / n, p);
+  int i = 1;
+
+  w[0] = 1;
+
+  for (; i < n / 2; i++)
+    w[i] = (BLlimb)(w[i - 1] * g % p);
+}
+
+/*
+ * lNtt.
+ *
+ * Number-theoretic transform modulo p, in place.
+ * The forward transform (inv = 0) leaves the data on bit-reversed order, and the inverse
+ * (inv = 1) takes it on that order, so no reordering is needed between them.
+ */
+static void lNtt(BLlimb* a, int n, BLlimb p, BLlimb* w, int inv) {
+  int len;
+  int half;
+  int step;
+  int i;
+  int j;
+  BLlimb u;
+  BLlimb v;
+  BLdlimb ni;
+
+  if (inv == 0) {
+    //decimation in frequency
+    for (len = n; len >= 2; len >>= 1) {
+      half = len >> 1;
+      step = n / len;
+
+      for (i = 0; i < n; i += len) {
+        for (j = 0; j < half; j++) {
+          u = a[i + j];
+          v = a[i + j + half];
+
+          a[i + j] = u + v >= p ? u + v - p : u + v;
+          a[i + j + half] = (BLlimb)((BLdlimb)(u + p - v) * w[j * step] % p);
+        }
+      }
+    }
+  } else {
+    //decimation in time, with w^-t = -w^(n/2 - t)
+    for (len = 2; len <= n; len <<= 1) {
+      half = len >> 1;
+      step = n / len;
+
+      for (i = 0; i < n; i += len) {
+        for (j = 0; j < half; j++) {
+          u = a[i + j];
+          v = a[i + j + half];
+
+          if (j > 0)
+            v = (BLlimb)((BLdlimb)v * (p - w[n / 2 - j * step]) % p);
+
+          a[i + j] = u + v >= p ? u + v - p : u + v;
+          a[i + j + half] = u >= v ? u - v : u + p - v;
+        }
+      }
+    }
+
+    //scale by n^-1
+    ni = lPowMod((BLlimb)n, p - 2, p);
+
+    for (i = 0; i < n; i++)
+      a[i] = (BLlimb)(a[i] * ni % p);
+  }
+}
+
+/*
+ * lNttLoad.
+ *
+ * Loads na limbs reduced modulo p on a n-length transform buffer.
+ */
+static void lNttLoad(BLlimb* x, BLlimb* a, int na, int n, BLlimb p) {
+  int i = 0;
+
+  for (; i < na; i++)
+    x[i] = a[i] % p;
+
+  memset(x + na, 0, sizeof(BLlimb) * (n - na));
+}
+
+/*
+ * lMulNtt.
+ *
+ * Multiplication via number-theoretic transform.
+ * If a and b are the same, squaring is made with a single forward transform.
+ *
+ * The convolution is made modulo three primes (all the coefficients are below
+ * 2^23 * (10^9)^2, that is lower than their product) and rebuilt with CRT (Garner),
+ * so it's exact.
+ */
+static void lMulNtt(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  BLlimb p[3] = { NTT_P1, NTT_P2, NTT_P3 };
+  int sqr = (a == b && na == nb);
+  int nr = na + nb;
+  int n = lNttLen(nr);
+  int q = 0;
+  int i;
+  BLlimb* x = scr;
+  BLlimb* fb = x + 3 * n;
+  BLlimb* w = fb + n;
+  BLlimb* xq;
+  BLdlimb i12;
+  BLdlimb i13;
+  BLdlimb i23;
+  BLdlimb v2;
+  BLdlimb v3;
+  BLdlimb t;
+  BLdlimb lo;
+  BLdlimb carry = 0;
+
+  //convolution modulo each prime
+  for (; q < 3; q++) {
+    xq = x + q * n;
+
+    lNttRoots(w, n, p[q]);
+
+    lNttLoad(xq, a, na, n, p[q]);
+    lNtt(xq, n, p[q], w, 0);
+
+    //on squaring, a single transform is needed
+    if (sqr == 1)
+      fb = xq;
+    else {
+      lNttLoad(fb, b, nb, n, p[q]);
+      lNtt(fb, n, p[q], w, 0);
+    }
+
+    for (i = 0; i < n; i++)
+      xq[i] = (BLlimb)((BLdlimb)xq[i] * fb[i] % p[q]);
+
+    lNtt(xq, n, p[q], w, 1);
+  }
+
+  //CRT constants
+  i12 = lPowMod(NTT_P1 % NTT_P2, NTT_P2 - 2, NTT_P2);
+  i13 = lPowMod(NTT_P1 % NTT_P3, NTT_P3 - 2, NTT_P3);
+  i23 = lPowMod(NTT_P2 % NTT_P3, NTT_P3 - 2, NTT_P3);
+
+  for (i = 0; i < nr; i++) {
+    //x = v1 + v2 * p1 + v3 * p1 * p2
+    v2 = (x[n + i] + NTT_P2 - x[i] % NTT_P2) % NTT_P2 * i12 % NTT_P2;
+    v3 = ((x[2 * n + i] + NTT_P3 - x[i] % NTT_P3) % NTT_P3 * i13 % NTT_P3 + NTT_P3 - v2) % NTT_P3 * i23 % NTT_P3;
+
+    //t = v2 + v3 * p2 fits on 64 bits; x = t * p1 + v1 is split in base 10^9 to keep it that way
+    t = v3 * NTT_P2 + v2;
+    lo = (t % BL_BASE) * NTT_P1 + x[i];
+
+    carry += lo % BL_BASE;
+    r[i] = (BLlimb)(carry % BL_BASE);
+    carry = carry / BL_BASE + lo / BL_BASE + (t / BL_BASE) * NTT_P1;
+  }
+}
+
+/*
+ * lMul.
+ *
+ * Performs r = a * b. r has na + nb limbs and cannot overlap a or b.
+ * "scr" is a working buffer of lScratch(max(na, nb)) limbs.
+ *
+ * The algorithm is chosen by the operand size: schoolbook, Karatsuba, Toom-3 or NTT.
+ * If a and b are the same pointer with the same length, squaring is performed.
+ */
+void lMul(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  BLlimb* t;
+  int n;
+
+  //work with na >= nb
+  if (na < nb) {
+    t = a;
+    a = b;
+    b = t;
+
+    n = na;
+    na = nb;
+    nb = n;
+  }
+
+  if (a == b && na == nb && na < KARA_SQR_THRESHOLD)
+    lSqrBasecase(r, a, na);
+  else if (nb < KARA_THRESHOLD)
+    lMulBasecase(r, a, na, b, nb);
+  else if (nb >= NTT_THRESHOLD && na + nb <= NTT_MAX)
+    lMulNtt(r, a, na, b, nb, scr);
+  else if (2 * nb <= na)
+    lMulChunks(r, a, na, b, nb, nb, scr);
+  else if (na >= TOOM_THRESHOLD && nb > 2 * ((na + 2) / 3))
+    lMulToom(r, a, na, b, nb, scr);
+  else if (nb > (na + 1) / 2)
+    lMulKara(r, a, na, b, nb, scr);
+  else
+    lMulChunks(r, a, na, b, nb, (na + 1) / 2, scr);
+}
+
+/*
+ * lSqr.
+ *
+ * Performs r = a^2. r has 2n limbs and cannot overlap a.
+ */
+void lSqr(BLlimb* r, BLlimb* a, int n, BLlimb* scr) {
+  lMul(r, a, n, a, n, scr);
+}
+
+/*
+ * lScratch.
+ *
+ * Returns the working limbs lMul needs for operands up to n limbs.
+ */
+int lScratch(int n) {
+  int h = (n + 1) / 2;
+  int k = (n + 2) / 3;
+  int s;
+  int t;
+
+  if (n < KARA_THRESHOLD)
+    return 0;
+
+  //Karatsuba (or chunks of, at most, h limbs)
+  s = 4 * h + 4 + lScratch(h + 1);
+
+  if (n >= TOOM_THRESHOLD) {
+    t = 14 * k + 15 + lScratch(k + 1);
+
+    if (t > s)
+      s = t;
+  }
+
+  if (n >= NTT_THRESHOLD) {
+    //three residues, second operand and roots
+    t = lNttLen(2 * n);
+    t = 4 * t + t / 2;
+
+    if (t > s)
+      s = t;
+  }
+
+  return s;
+}
+
+//product of a lMulThreads branch
+typedef struct BLmulTask {
+  BLthread th;
+  BLlimb* r;
+  BLlimb* a;
+  int na;
+  BLlimb* b;
+  int nb;
+  BLlimb* scr;
+  int threads;
+} BLmulTask;
+
+static void lMulPar(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr, int threads);
+
+/*
+ * lMulParScratch.
+ *
+ * Returns the working limbs lMulPar needs for operands up to n limbs with the given threads.
+ */
+static int lMulParScratch(int n, int threads) {
+  int h = (n + 1) / 2;
+  int s = lScratch(n);
+  int t;
+
+  if (threads < 2 || n < MUL_THREAD_THRESHOLD)
+    return s;
+
+  //halves sums and middle product (or the high product on unbalanced operands), then three branches.
+  //A branch may end on lMul, so it's never less than lScratch(n)
+  t = 4 * h + 4 + 3 * lMulParScratch(h + 1, (threads + 1) / 2);
+
+  return t > s ? t : s;
+}
+
+/*
+ * lMulTask.
+ *
+ * Thread entry for a lMulPar branch.
+ */
+static BL_THREAD_FN lMulTask(void* vt) {
+  BLmulTask* t = (BLmulTask*)vt;
+
+  lMulPar(t->r, t->a, t->na, t->b, t->nb, t->scr, t->threads);
+
+  return 0;
+}
+
+/*
+ * lMulRun.
+ *
+ * Runs k branches over the given threads: branch i gets its share of threads to go on splitting,
+ * branches 1 .. threads - 1 get a thread of their own and the rest are made by the caller.
+ */
+static void lMulRun(BLmulTask* t, int k, int threads) {
+  int i = 0;
+  int w = threads < k ? threads : k;
+
+  for (; i < k; i++) {
+    t[i].threads = threads / k + (i < threads % k ? 1 : 0);
+
+    if (t[i].threads < 1)
+      t[i].threads = 1;
+  }
+
+  //if a thread cannot be started, its branch is made here
+  for (i = 1; i < w; i++)
+    if (BL_THREAD_START(t[i].th, lMulTask, t + i) != 0)
+      t[i].threads = 0;
+
+  lMulTask(t);
+
+  for (i = w; i < k; i++)
+    lMulTask(t + i);
+
+  for (i = 1; i < w; i++) {
+    if (t[i].threads == 0)
+      lMulTask(t + i);
+    else
+      BL_THREAD_JOIN(t[i].th);
+  }
+}
+
+/*
+ * lMulPar.
+ *
+ * Parallel multiplication. The top levels are split as Karatsuba (or in two halves of "a" on
+ * unbalanced operands) and every branch runs on its own thread with its own scratch, splitting
+ * again while there are threads left. Below MUL_THREAD_THRESHOLD limbs it's lMul.
+ * "scr" has lMulParScratch(max(na, nb), threads) limbs.
+ */
+static void lMulPar(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr, int threads) {
+  BLmulTask t[3];
+  BLlimb* sa;
+  BLlimb* sb;
+  BLlimb* p;
+  BLlimb* next;
+  int h;
+  int n;
+  int c;
+  int i = 0;
+
+  //work with na >= nb
+  if (na < nb) {
+    p = a;
+    a = b;
+    b = p;
+
+    n = na;
+    na = nb;
+    nb = n;
+  }
+
+  if (threads < 2 || nb < MUL_THREAD_THRESHOLD) {
+    lMul(r, a, na, b, nb, scr);
+    return;
+  }
+
+  h = (na + 1) / 2;
+  c = lMulParScratch(h + 1, (threads + 1) / 2);
+  sa = scr;
+  sb = sa + h + 1;
+  p = sb + h + 1;
+  next = p + 2 * h + 2;
+
+  if (nb > h) {
+    //Karatsuba, as lMulKara
+    sa[h] = lAdd1(sa + (na - h), a + (na - h), 2 * h - na, lAdc(sa, a, a + h, na - h, 0));
+
+    if (a == b && na == nb)
+      sb = sa;
+    else
+      sb[h] = lAdd1(sb + (nb - h), b + (nb - h), 2 * h - nb, lAdc(sb, b, b + h, nb - h, 0));
+
+    t[0].r = r;
+    t[0].a = a;
+    t[0].na = h;
+    t[0].b = b;
+    t[0].nb = h;
+
+    t[1].r = r + 2 * h;
+    t[1].a = a + h;
+    t[1].na = na - h;
+    t[1].b = b + h;
+    t[1].nb = nb - h;
+
+    t[2].r = p;
+    t[2].a = sa;
+    t[2].na = h + 1;
+    t[2].b = sb;
+    t[2].nb = h + 1;
+
+    for (; i < 3; i++)
+      t[i].scr = next + i * c;
+
+    lMulRun(t, 3, threads);
+
+    lSubFrom(p, 2 * h + 2, r, lLen(r, 2 * h));
+    lSubFrom(p, 2 * h + 2, r + 2 * h, lLen(r + 2 * h, na + nb - 2 * h));
+
+    lAddTo(r + h, na + nb - h, p, lLen(p, 2 * h + 2));
+  } else {
+    //unbalanced: a0 * b goes to its place and a1 * b is added with its offset
+    t[0].r = r;
+    t[0].a = a;
+    t[0].na = h;
+    t[0].b = b;
+    t[0].nb = nb;
+
+    t[1].r = p;
+    t[1].a = a + h;
+    t[1].na = na - h;
+    t[1].b = b;
+    t[1].nb = nb;
+
+    for (; i < 2; i++)
+      t[i].scr = next + i * c;
+
+    lMulRun(t, 2, threads);
+
+    memset(r + h + nb, 0, sizeof(BLlimb) * (na - h));
+    lAddTo(r + h, na + nb - h, p, lLen(p, na - h + nb));
+  }
+}
+
+/*
+ * lMulThreads.
+ *
+ * Performs r = a * b as lMul, splitting the work between "threads" threads when the operands
+ * are big enough (MUL_THREAD_THRESHOLD limbs). "scr" is the lScratch(max(na, nb)) buffer of lMul;
+ * the parallel branches get their own buffer, and if it cannot be allocated lMul is used.
+ */
+void lMulThreads(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr, int threads) {
+  BLlimb* par;
+
+  if (threads < 2 || na < MUL_THREAD_THRESHOLD || nb < MUL_THREAD_THRESHOLD) {
+    lMul(r, a, na, b, nb, scr);
+    return;
+  }
+
+  par = malloc(sizeof(BLlimb) * lMulParScratch(na > nb ? na : nb, threads));
+
+  if (par == NULL) {
+    lMul(r, a, na, b, nb, scr);
+    return;
+  }
+
+  lMulPar(r, a, na, b, nb, par, threads);
+
+  free(par);
+}
+
+/*
+ * lDivKnuth.
+ *
+ * Schoolbook division (Knuth, algorithm D). u has nu limbs and v has n limbs (n >= 2),
+ * being v normalized (v[n - 1] >= BL_BASE / 2) and u / v < BL_BASE^(nu - n).
+ * q gets the nu - n quotient limbs, and u is left with the remainder on its n lower limbs.
+ */
+static void lDivKnuth(BLlimb* q, BLlimb* u, int nu, BLlimb* v, int n) {
+  int j = nu - n - 1;
+  BLdlimb num;
+  BLdlimb qh;
+  BLdlimb rh;
+  BLlimb c;
+
+  for (; j >= 0; j--) {
+    //estimate the quotient limb with the two upper limbs of u and the upper limb of v
+    num = (BLdlimb)u[j + n] * BL_BASE + u[j + n - 1];
+    qh = num / v[n - 1];
+    rh = num - qh * v[n - 1];
+
+    //refine it with the second limb of v (at most two steps)
+    while (qh >= BL_BASE || qh * v[n - 2] > rh * BL_BASE + u[j + n - 2]) {
+      --qh;
+      rh += v[n - 1];
+
+      if (rh >= BL_BASE)
+        break;
+    }
+
+    //u -= qh * v * B^j
+    c = lMsb(u + j, v, n, (BLlimb)qh);
+
+    if (u[j + n] < c) {
+      //qh was one unit too big: add v back
+      --qh;
+      lAdc(u + j, u + j, v, n, 0);
+    }
+
+    u[j + n] = 0;
+    q[j] = (BLlimb)qh;
+  }
+}
+
+/*
+ * lInvScratch.
+ *
+ * Returns the working limbs lInv needs for a n limbs divisor.
+ */
+static int lInvScratch(int n) {
+  int h = (n + 3) / 2;
+  int s;
+  int t;
+
+  if (n < DIV_NEWTON_THRESHOLD)
+    return 2 * n + 2;
+
+  s = lInvScratch(h);
+  t = lScratch(2 * n + 2);
+
+  return (h + 1) + (2 * n + 2) + (2 * n + 2) + (3 * n + 4) + (s > t ? s : t);
+}
+
+/*
+ * lInv.
+ *
+ * Calculates x = floor(B^2n / v), being v a normalized divisor of n limbs. x has n + 1 limbs.
+ * "scr" is a working buffer of lInvScratch(n) limbs.
+ *
+ * The reciprocal of the upper half of v is calculated first (recursively) and then a single
+ * Newton step x += x * (B^2n - v * x) / B^2n doubles its precision. The last units are fixed
+ * by comparing v * x against B^2n.
+ */
+static void lInv(BLlimb* x, BLlimb* v, int n, BLlimb* scr) {
+  int h = (n + 3) / 2;
+  int nd;
+  BLlimb* xh = scr;
+  BLlimb* p = xh + h + 1;
+  BLlimb* d = p + 2 * n + 2;
+  BLlimb* t = d + 2 * n + 2;
+  BLlimb* next = t + 3 * n + 4;
+
+  if (n < DIV_NEWTON_THRESHOLD) {
+    //small divisor: B^2n / v in a single schoolbook division
+    memset(scr, 0, sizeof(BLlimb) * (2 * n + 2));
+    scr[2 * n] = 1;
+
+    lDivKnuth(x, scr, 2 * n + 1, v, n);
+
+    return;
+  }
+
+  //xh = floor(B^2h / vh). As vh <= v / B^(n - h), xh * B^(n - h) is close to B^2n / v
+  lInv(xh, v + n - h, h, next);
+
+  memset(x, 0, sizeof(BLlimb) * (n - h));
+  memcpy(x + n - h, xh, sizeof(BLlimb) * (h + 1));
+
+  //p = v * x (2n + 1 limbs)
+  lMul(p, x, n + 1, v, n, next);
+
+  //d = |B^2n - p|. The Newton step x * d / B^2n is calculated as xh * d / B^(n + h)
+  if (p[2 * n] > 0) {
+    //p >= B^2n: x is too big. Rounding is left to the final fix
+    memcpy(d, p, sizeof(BLlimb) * 2 * n);
+    nd = lLen(d, 2 * n);
+
+    if (nd > 0) {
+      lMul(t, xh, h + 1, d, nd, next);
+
+      if (h + 1 + nd > n + h)
+        lSubFrom(x, n + 1, t + n + h, lLen(t + n + h, nd + 1 - n));
+    }
+  } else {
+    //p < B^2n: x is too small
+    memset(d, 0, sizeof(BLlimb) * (2 * n + 1));
+    d[2 * n] = 1;
+    lSubFrom(d, 2 * n + 1, p, lLen(p, 2 * n + 1));
+    nd = lLen(d, 2 * n + 1);
+
+    lMul(t, xh, h + 1, d, nd, next);
+
+    if (h + 1 + nd > n + h)
+      lAddTo(x, n + 1, t + n + h, lLen(t + n + h, nd + 1 - n));
+  }
+
+  //fix the last units: 0 <= B^2n - v * x < v
+  lMul(p, x, n + 1, v, n, next);
+
+  while (p[2 * n] > 1 || (p[2 * n] == 1 && lLen(p, 2 * n) > 0)) {
+    lSub1(x, x, n + 1, 1);
+    lSubFrom(p, 2 * n + 1, v, n);
+  }
+
+  memset(d, 0, sizeof(BLlimb) * (2 * n + 1));
+  d[2 * n] = 1;
+  lSubFrom(d, 2 * n + 1, p, lLen(p, 2 * n + 1));
+
+  while (lCmp(d, 2 * n + 1, v, n) != 2) {
+    lAdd1(x, x, n + 1, 1);
+    lSubFrom(d, 2 * n + 1, v, n);
+  }
+}
+
+/*
+ * lDivBarrett.
+ *
+ * Division with a precomputed reciprocal. Same contract as lDivKnuth, but u needs a
+ * (nu + 1)th limb to work on, and q gets nu - n + 1 limbs (the upper one is always 0).
+ * "scr" is a working buffer of lDivScratch(nu, n) limbs.
+ *
+ * u is processed from the top on windows of, at most, 2n limbs. On every window the
+ * quotient is estimated as floor(floor(w / B^(n - 1)) * mu / B^(n + 1)), being
+ * mu = floor(B^2n / v) (n + 1 limbs, given by lInv), that is, at most, 2 units below the real one.
+ */
+static void lDivBarrett(BLlimb* q, BLlimb* u, int nu, BLlimb* v, int n, BLlimb* mu, BLlimb* scr) {
+  int p = nu + 1 - n;
+  int len;
+  int nt;
+  BLlimb* t = scr;
+  BLlimb* next = t + 2 * n + 2;
+
+  //with the extra limb set to 0, the n upper limbs of u are below v
+  u[nu] = 0;
+
+  while (p > 0) {
+    len = (p - 1) % n + 1;
+    p -= len;
+
+    //t = floor(w / B^(n - 1)) * mu; the estimation is on t[n + 1 .. n + len]
+    lMul(t, u + p + n - 1, len + 1, mu, n + 1, next);
+    memcpy(q + p, t + n + 1, sizeof(BLlimb) * len);
+
+    //w -= q * v
+    nt = lLen(q + p, len);
+
+    if (nt > 0) {
+      lMul(t, q + p, nt, v, n, next);
+      lSubFrom(u + p, n + len, t, lLen(t, nt + n));
+    }
+
+    //fix the last units
+    while (lCmp(u + p, n + len, v, n) != 2) {
+      lSubFrom(u + p, n + len, v, n);
+      lAdd1(q + p, q + p, len, 1);
+    }
+  }
+}
+
+/*
+ * lDivScratch.
+ *
+ * Returns the working limbs lDivRem needs for a dividend up to na limbs and a divisor up to nb limbs.
+ */
+int lDivScratch(int na, int nb) {
+  int s = (na + 2) + nb + (na + 3);
+  int t;
+
+  if (nb >= DIV_NEWTON_THRESHOLD) {
+    t = lInvScratch(nb);
+
+    if (t < lScratch(nb + 1))
+      t = lScratch(nb + 1);
+
+    s += (nb + 1) + (2 * nb + 2) + t;
+  }
+
+  return s;
+}
+
+/*
+ * lDivNorm.
+ *
+ * Divides a (na limbs) by v (nb >= 2 limbs), being v the divisor multiplied by d (so its upper limb
+ * is, at least, BL_BASE / 2) and mu its reciprocal (only from DIV_NEWTON_THRESHOLD limbs).
+ * Same contract as lDivRem.
+ */
+static void lDivNorm(BLlimb* q, BLlimb* r, BLlimb* a, int na, BLlimb* v, int nb, BLlimb d, BLlimb* mu, BLlimb* scr) {
+  BLlimb* u = scr;
+  BLlimb* qt = u + na + 2;
+  BLlimb* next = qt + na + 3;
+
+  //u = a * d
+  memset(u, 0, sizeof(BLlimb) * (na + 2));
+  u[na] = lMac(u, a, na, d);
+
+  if (nb < DIV_NEWTON_THRESHOLD)
+    lDivKnuth(q, u, na + 1, v, nb);
+  else {
+    lDivBarrett(qt, u, na + 1, v, nb, mu, next);
+    memcpy(q, qt, sizeof(BLlimb) * (na - nb + 1));
+  }
+
+  //denormalize the remainder
+  lDiv1(r, u, nb, d);
+}
+
+/*
+ * lDivRem.
+ *
+ * Performs q = a / b and r = a % b, being na >= nb and b[nb - 1] != 0.
+ * q has na - nb + 1 limbs and r has nb limbs; none of them can overlap a or b.
+ * "scr" is a working buffer of lDivScratch(na, nb) limbs.
+ *
+ * Both operands are normalized (so the upper limb of b is, at least, BL_BASE / 2) and the
+ * algorithm is chosen by the divisor size: schoolbook (Knuth D) or Newton reciprocal.
+ */
+void lDivRem(BLlimb* q, BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  BLlimb d;
+  BLlimb* v = scr;
+  BLlimb* mu = v + nb;
+  BLlimb* next = nb < DIV_NEWTON_THRESHOLD ? mu : mu + nb + 1;
+
+  if (nb == 1) {
+    r[0] = lDiv1(q, a, na, b[0]);
+    return;
+  }
+
+  //normalize: v = b * d
+  d = BL_BASE / (b[nb - 1] + 1);
+
+  memset(v, 0, sizeof(BLlimb) * nb);
+  lMac(v, b, nb, d);
+
+  if (nb >= DIV_NEWTON_THRESHOLD)
+    lInv(mu, v, nb, next);
+
+  lDivNorm(q, r, a, na, v, nb, d, mu, next);
+}
+
+/*
+ * lDivInit.
+ *
+ * Loads the divisor b (nb limbs, b[nb - 1] != 0) on the context c, so its normalization (and its
+ * reciprocal, from DIV_NEWTON_THRESHOLD limbs) is made once for every lDivPre.
+ * "scr" is a working buffer of lDivScratch(nb, nb) limbs.
+ */
+void lDivInit(BLdiv* c, BLlimb* b, int nb, BLlimb* scr) {
+  c->k = nb;
+  c->d = nb == 1 ? 1 : BL_BASE / (b[nb - 1] + 1);
+
+  memset(c->v, 0, sizeof(BLlimb) * nb);
+  lMac(c->v, b, nb, c->d);
+
+  if (nb >= DIV_NEWTON_THRESHOLD)
+    lInv(c->mu, c->v, nb, scr);
+}
+
+/*
+ * lDivPre.
+ *
+ * As lDivRem, being the divisor the one of the context c (na >= c->k).
+ */
+void lDivPre(BLlimb* q, BLlimb* r, BLlimb* a, int na, BLdiv* c, BLlimb* scr) {
+  if (c->k == 1) {
+    r[0] = lDiv1(q, a, na, c->v[0]);
+    return;
+  }
+
+  lDivNorm(q, r, a, na, c->v, c->k, c->d, c->mu, scr);
+}
+
+/*
+ * lInvLimb.
+ *
+ * Returns -a^-1 mod BL_BASE (a shall be coprime with 10), via extended Euclid.
+ */
+static BLlimb lInvLimb(BLlimb a) {
+  long long r0 = BL_BASE;
+  long long r1 = a;
+  long long s0 = 0;
+  long long s1 = 1;
+  long long q;
+  long long t;
+
+  while (r1 != 0) {
+    q = r0 / r1;
+
+    t = r0 - q * r1;
+    r0 = r1;
+    r1 = t;
+
+    t = s0 - q * s1;
+    s0 = s1;
+    s1 = t;
+  }
+
+  //s0 * a = 1 (mod BL_BASE)
+  s0 %= (long long)BL_BASE;
+
+  if (s0 < 0)
+    s0 += BL_BASE;
+
+  return s0 == 0 ? 0 : BL_BASE - (BLlimb)s0;
+}
+
+/*
+ * lMontInit.
+ *
+ * Loads the modulus n (k limbs, n[k - 1] != 0) on the Montgomery context and precomputes
+ * R mod n and R^2 mod n, being R = BL_BASE^k. "scr" is a working buffer of lMontScratch(k, 0) limbs.
+ *
+ * Montgomery reduction needs n coprime with BL_BASE (that is, with 10). Otherwise, "redc" is
+ * left to 0 and the products are reduced by division.
+ */
+void lMontInit(BLmont* c, BLlimb* n, int k, BLlimb* scr) {
+  BLlimb* u = scr;
+  BLlimb* q = u + 2 * k + 2;
+  BLlimb* next = q + k + 2;
+
+  c->k = k;
+  memcpy(c->n, n, sizeof(BLlimb) * k);
+
+  c->redc = (n[0] % 2 != 0 && n[0] % 5 != 0);
+  c->ni = c->redc == 1 ? lInvLimb(n[0]) : 0;
+
+  //R mod n (1 mod n if there's no Montgomery form)
+  memset(u, 0, sizeof(BLlimb) * (k + 1));
+
+  if (c->redc == 1)
+    u[k] = 1;
+  else
+    u[0] = 1;
+
+  lDivRem(q, c->one, u, k + 1, n, k, next);
+
+  //R^2 mod n
+  memset(u, 0, sizeof(BLlimb) * (2 * k + 1));
+  u[2 * k] = 1;
+  lDivRem(q, c->r2, u, 2 * k + 1, n, k, next);
+}
+
+/*
+ * lMontRedc.
+ *
+ * Reduces t (2k limbs, t < n * R) to r = t mod n, in Montgomery form (t * R^-1 mod n) if the
+ * context allows it. r has k limbs and cannot overlap t. t is modified.
+ * "scr" is a working buffer of lMontScratch(k, 0) limbs.
+ */
+static void lMontRedc(BLlimb* r, BLlimb* t, BLmont* c, BLlimb* scr) {
+  int k = c->k;
+  int i = 0;
+  BLlimb u;
+  BLlimb cy;
+
+  if (c->redc == 0) {
+    //plain reduction
+    lDivRem(scr, r, t, 2 * k, c->n, k, scr + k + 1);
+    return;
+  }
+
+  t[2 * k] = 0;
+
+  //t += u * n * B^i, with u chosen so the lower limb gets 0
+  for (; i < k; i++) {
+    u = (BLlimb)((BLdlimb)t[i] * c->ni % BL_BASE);
+
+    cy = lMac(t + i, c->n, k, u);
+    lAddTo(t + i + k, k + 1 - i, &cy, 1);
+  }
+
+  //t / R < 2n
+  if (lCmp(t + k, k + 1, c->n, k) != 2)
+    lSubFrom(t + k, k + 1, c->n, k);
+
+  memcpy(r, t + k, sizeof(BLlimb) * k);
+}
+
+/*
+ * lMontMul.
+ *
+ * Performs r = a * b * R^-1 mod n (or a * b mod n if the context is not on Montgomery mode).
+ * a and b have k limbs and are below n; r can overlap them. If a and b are the same, squaring
+ * is performed. "scr" is a working buffer of lMontScratch(k, 0) limbs.
+ */
+void lMontMul(BLlimb* r, BLlimb* a, BLlimb* b, BLmont* c, BLlimb* scr) {
+  int k = c->k;
+  BLlimb* t = scr;
+  BLlimb* next = t + 2 * k + 2;
+
+  lMul(t, a, k, b, k, next);
+  lMontRedc(r, t, c, next);
+}
+
+/*
+ * lMontTo.
+ *
+ * Moves a (na limbs, any value) into Montgomery form: r = a * R mod n (k limbs).
+ * "scr" is a working buffer of lMontScratch(k, na) limbs.
+ */
+void lMontTo(BLlimb* r, BLlimb* a, int na, BLmont* c, BLlimb* scr) {
+  int k = c->k;
+  BLlimb* q = scr;
+  BLlimb* next = q + na + 1;
+
+  //reduce a, if needed
+  na = lLen(a, na);
+
+  if (na >= k) {
+    lDivRem(q, r, a, na, c->n, k, next);
+  } else {
+    memset(r, 0, sizeof(BLlimb) * k);
+    memcpy(r, a, sizeof(BLlimb) * na);
+  }
+
+  if (c->redc == 1)
+    lMontMul(r, r, c->r2, c, scr);
+}
+
+/*
+ * lMontFrom.
+ *
+ * Moves a (k limbs) out of Montgomery form: r = a * R^-1 mod n. r can overlap a.
+ * "scr" is a working buffer of lMontScratch(k, 0) limbs.
+ */
+void lMontFrom(BLlimb* r, BLlimb* a, BLmont* c, BLlimb* scr) {
+  int k = c->k;
+  BLlimb* t = scr;
+
+  if (c->redc == 0) {
+    memmove(r, a, sizeof(BLlimb) * k);
+    return;
+  }
+
+  memset(t, 0, sizeof(BLlimb) * (2 * k + 2));
+  memcpy(t, a, sizeof(BLlimb) * k);
+
+  lMontRedc(r, t, c, t + 2 * k + 2);
+}
+
+/*
+ * lWindow.
+ *
+ * Returns the sliding window size for an exponent of "bits" bits.
+ */
+static int lWindow(int bits) {
+  if (bits > 671)
+    return 6;
+  else if (bits > 239)
+    return 5;
+  else if (bits > 79)
+    return 4;
+  else if (bits > 23)
+    return 3;
+  else if (bits > 1)
+    return 2;
+
+  return 1;
+}
+
+/*
+ * lBit.
+ *
+ * Returns the i-th bit of a number stored on BL_BITS-bit words.
+ */
+static int lBit(BLlimb* w, int i) {
+  return (w[i / BL_BITS] >> (i % BL_BITS)) & 1;
+}
+
+/*
+ * lMontPow.
+ *
+ * Performs r = a^e mod n with left-to-right sliding windows. a (k limbs) is on Montgomery
+ * form and so it is r; e has ne limbs. "scr" is a working buffer of lMontScratch(k, ne) limbs.
+ */
+void lMontPow(BLlimb* r, BLlimb* a, BLlimb* e, int ne, BLmont* c, BLlimb* scr) {
+  int k = c->k;
+  int nw = 0;
+  int bits;
+  int w;
+  int i;
+  int j;
+  int l;
+  int v;
+  int first = 1;
+  BLlimb* bw = scr;
+  BLlimb* et = bw + 2 * ne + 2;
+  BLlimb* g = et + ne + 1;
+  BLlimb* next = g + (1 << (MONT_WINDOW - 1)) * k;
+
+  //exponent on binary words
+  ne = lLen(e, ne);
+  memcpy(et, e, sizeof(BLlimb) * ne);
+
+  while (ne > 0) {
+    bw[nw++] = lDiv1(et, et, ne, 1u << BL_BITS);
+    ne = lLen(et, ne);
+  }
+
+  bits = nw * BL_BITS;
+
+  while (bits > 0 && lBit(bw, bits - 1) == 0)
+    --bits;
+
+  //a^0 = 1
+  if (bits == 0) {
+    memcpy(r, c->one, sizeof(BLlimb) * k);
+    return;
+  }
+
+  w = lWindow(bits);
+
+  if (w > MONT_WINDOW)
+    w = MONT_WINDOW;
+
+  //odd powers: g[i] = a^(2i + 1). r is used to keep a^2
+  memcpy(g, a, sizeof(BLlimb) * k);
+
+  if (w > 1) {
+    lMontMul(r, a, a, c, next);
+
+    for (i = 1; i < (1 << (w - 1)); i++)
+      lMontMul(g + i * k, g + (i - 1) * k, r, c, next);
+  }
+
+  for (i = bits - 1; i >= 0;) {
+    if (lBit(bw, i) == 0) {
+      lMontMul(r, r, r, c, next);
+      --i;
+
+      continue;
+    }
+
+    //the window ends on the lowest set bit, at most w bits below
+    j = i - w + 1 < 0 ? 0 : i - w + 1;
+
+    while (lBit(bw, j) == 0)
+      ++j;
+
+    for (v = 0, l = i; l >= j; l--)
+      v = (v << 1) | lBit(bw, l);
+
+    if (first == 1) {
+      memcpy(r, g + (v >> 1) * k, sizeof(BLlimb) * k);
+      first = 0;
+    } else {
+      for (l = i; l >= j; l--)
+        lMontMul(r, r, r, c, next);
+
+      lMontMul(r, r, g + (v >> 1) * k, c, next);
+    }
+
+    i = j - 1;
+  }
+}
+
+/*
+ * lMontScratch.
+ *
+ * Returns the working limbs the Montgomery functions need for a k limbs modulus and
+ * operands (or exponents) up to na limbs.
+ */
+int lMontScratch(int k, int na) {
+  int s = (2 * k + 2) + lScratch(k);
+  int t = lDivScratch(2 * k + 2, k) + (k + 2) + (2 * k + 2);
+  int x;
+
+  if (t > s)
+    s = t;
+
+  //reduction of a na limbs operand
+  x = (na + 1) + lDivScratch(na, k);
+
+  if (x > s)
+    s = x;
+
+  //exponent words (29 bits each, so a bit more than na), its copy and window table
+  return s + 3 * na + 3 + (1 << (MONT_WINDOW - 1)) * k;
+}
+
+/*
+ * lBarrettInit.
+ *
+ * Loads the modulus n (k limbs, n[k - 1] != 0) on the Barrett context and precomputes
+ * mu = floor(BL_BASE^2k / n). "scr" is a working buffer of lBarrettScratch(k, 0) limbs.
+ */
+void lBarrettInit(BLbarrett* c, BLlimb* n, int k, BLlimb* scr) {
+  BLlimb* u = scr;
+  BLlimb* r = u + 2 * k + 2;
+  BLlimb* next = r + k;
+
+  c->k = k;
+  memcpy(c->n, n, sizeof(BLlimb) * k);
+
+  //mu has k + 2 limbs (k + 1 unless n = BL_BASE^(k - 1))
+  memset(u, 0, sizeof(BLlimb) * (2 * k + 1));
+  u[2 * k] = 1;
+  lDivRem(c->mu, r, u, 2 * k + 1, n, k, next);
+}
+
+/*
+ * lBarrett.
+ *
+ * Performs r = x mod n (r has k limbs and cannot overlap x). If x has up to 2k limbs, the
+ * quotient is estimated with two multiplications (it's short by 2 at most); bigger values
+ * are divided. "scr" is a working buffer of lBarrettScratch(k, nx) limbs.
+ */
+void lBarrett(BLlimb* r, BLlimb* x, int nx, BLbarrett* c, BLlimb* scr) {
+  int k = c->k;
+  int nq;
+  BLlimb* q2 = scr;
+  BLlimb* r2 = q2 + 2 * k + 3;
+  BLlimb* next = r2 + 2 * k + 2;
+
+  nx = lLen(x, nx);
+
+  //x < BL_BASE^(k - 1) <= n
+  if (nx < k) {
+    memset(r, 0, sizeof(BLlimb) * k);
+    memcpy(r, x, sizeof(BLlimb) * nx);
+    return;
+  }
+
+  //out of Barrett range
+  if (nx > 2 * k) {
+    lDivRem(scr, r, x, nx, c->n, k, scr + nx - k + 1);
+    return;
+  }
+
+  //q3 = floor(floor(x / B^(k - 1)) * mu / B^(k + 1))
+  nq = nx - k + 1;
+  lMul(q2, x + k - 1, nq, c->mu, k + 2, next);
+
+  //r2 = q3 * n mod B^(k + 1). q3 has nq + 1 limbs at most
+  lMul(r2, q2 + k + 1, nq + 1, c->n, k, next);
+
+  //r = x - r2 mod B^(k + 1), being r < 3n
+  memset(next, 0, sizeof(BLlimb) * (k + 1));
+  memcpy(next, x, sizeof(BLlimb) * (nx < k + 1 ? nx : k + 1));
+  lSbb(next, next, r2, k + 1, 0);
+
+  while (lCmp(next, k + 1, c->n, k) != 2)
+    lSubFrom(next, k + 1, c->n, k);
+
+  memcpy(r, next, sizeof(BLlimb) * k);
+}
+
+/*
+ * lBarrettScratch.
+ *
+ * Returns the working limbs the Barrett functions need for a k limbs modulus and values up
+ * to nx limbs.
+ */
+int lBarrettScratch(int k, int nx) {
+  int s = (2 * k + 3) + (2 * k + 2) + lScratch(k + 2);
+  int t = (2 * k + 2) + k + lDivScratch(2 * k + 1, k);
+
+  if (t > s)
+    s = t;
+
+  //values out of Barrett range
+  if (nx > 2 * k) {
+    t = (nx - k + 1) + lDivScratch(nx, k);
+
+    if (t > s)
+      s = t;
+  }
+
+  return s;
+}
+
+/*
+ * lPowCap.
+ *
+ * Performs r = a^e (e >= 1) as long as the result fits on "cap" limbs. Returns the limbs of r,
+ * or 0 if a^e is bigger. r and t have 2 * cap + 4 limbs; "scr" is a working buffer of
+ * lScratch(cap + 2) limbs.
+ */
+static int lPowCap(BLlimb* r, BLlimb* a, int na, int e, int cap, BLlimb* t, BLlimb* scr) {
+  int i = 0;
+  int nr;
+
+  na = lLen(a, na);
+
+  if (na > cap)
+    return 0;
+
+  while ((e >> (i + 1)) > 0)
+    ++i;
+
+  memcpy(r, a, sizeof(BLlimb) * na);
+  nr = na;
+
+  for (--i; i >= 0; i--) {
+    //r^2 has 2nr - 1 limbs, at least
+    if (2 * nr - 1 > cap)
+      return 0;
+
+    lMul(t, r, nr, r, nr, scr);
+    nr = lLen(t, 2 * nr);
+
+    if (((e >> i) & 1) == 1) {
+      if (nr + na - 1 > cap)
+        return 0;
+
+      lMul(r, t, nr, a, na, scr);
+      nr = lLen(r, nr + na);
+    } else
+      memcpy(r, t, sizeof(BLlimb) * nr);
+
+    if (nr > cap)
+      return 0;
+  }
+
+  return nr;
+}
+
+/*
+ * lRootScratch.
+ *
+ * Returns the working limbs lRoot needs for a radicand up to na limbs.
+ */
+int lRootScratch(int na) {
+  int s = lScratch(na + 2);
+  int t = lDivScratch(na, na);
+
+  if (t > s)
+    s = t;
+
+  s += 2 * (na + 3) + 2 * (2 * na + 4) + (na + 2) + (na + 1);
+
+  //the initial approximation is made over (at most) 3/4 of the limbs
+  if (na > 4)
+    s += lRootScratch((3 * na) / 4 + 1);
+
+  return s;
+}
+
+/*
+ * lRoot.
+ *
+ * Performs r = floor(a^(1/n)), n >= 1. r has na limbs. Returns the limbs of r.
+ * "scr" is a working buffer of lRootScratch(na) limbs.
+ *
+ * Newton's iteration x' = ((n - 1) * x + a / x^(n - 1)) / n decreases until it reaches the root, as
+ * long as it starts over it. The start point is the root of the upper half of a, so every level
+ * doubles the precision; small roots (up to 2 limbs) are found by bisection. Square roots don't
+ * need any power, as x^(n - 1) = x.
+ */
+int lRoot(BLlimb* r, BLlimb* a, int na, int n, BLlimb* scr) {
+  int nr;
+  int s;
+  int nx;
+  int ny;
+  int np;
+  int nq;
+  int i;
+  BLlimb* x = scr;
+  BLlimb* y = x + na + 3;
+  BLlimb* p = y + na + 3;
+  BLlimb* t = p + 2 * na + 4;
+  BLlimb* q = t + 2 * na + 4;
+  BLlimb* rem = q + na + 2;
+  BLlimb* next = rem + na + 1;
+  BLlimb* sw;
+  BLdlimb lo = 0;
+  BLdlimb hi;
+  BLdlimb mid;
+
+  na = lLen(a, na);
+
+  //0 and 1 are their own roots, as well as any number for n = 1
+  if (na == 0 || n == 1 || (na == 1 && a[0] == 1)) {
+    memcpy(r, a, sizeof(BLlimb) * na);
+    return na;
+  }
+
+  //a < B^na < 2^(30na), so the root is below 2^(30na / n)
+  if (n >= 30 * na) {
+    r[0] = 1;
+    return 1;
+  }
+
+  //root limbs
+  nr = (na + n - 1) / n;
+
+  if (nr <= 2) {
+    //bisection over [lo, hi), being lo^n <= a < hi^n
+    i = (30 * na + n - 1) / n;
+    hi = (BLdlimb)1 << (i > 60 ? 60 : i);
+
+    while (hi - lo > 1) {
+      mid = lo + (hi - lo) / 2;
+
+      y[0] = (BLlimb)(mid % BL_BASE);
+      y[1] = (BLlimb)(mid / BL_BASE % BL_BASE);
+      y[2] = (BLlimb)(mid / BL_BASE / BL_BASE);
+
+      np = lPowCap(p, y, 3, n, na, t, next);
+
+      if (np > 0 && lCmp(p, np, a, na) != 1)
+        lo = mid;
+      else
+        hi = mid;
+    }
+
+    r[0] = (BLlimb)(lo % BL_BASE);
+    r[1] = (BLlimb)(lo / BL_BASE);
+
+    return lLen(r, 2);
+  }
+
+  //x = (root(a / B^(n * s)) + 1) * B^s, over the root
+  s = nr / 2;
+
+  memset(x, 0, sizeof(BLlimb) * (na + 3));
+  lRoot(x + s, a + n * s, na - n * s, n, next);
+  lAdd1(x + s, x + s, na + 2 - s, 1);
+
+  nx = lLen(x, na + 2);
+
+  for (;;) {
+    //p = x^(n - 1)
+    if (n == 2) {
+      sw = x;
+      np = nx;
+    } else {
+      sw = p;
+      np = lPowCap(p, x, nx, n - 1, na, t, next);
+    }
+
+    //q = a / x^(n - 1) (0 if the power is bigger than a)
+    nq = 0;
+
+    if (np > 0 && np <= na) {
+      lDivRem(q, rem, a, na, sw, np, next);
+      nq = na - np + 1;
+    }
+
+    //y = ((n - 1) * x + q) / n
+    memset(y, 0, sizeof(BLlimb) * (na + 3));
+    y[nx] = lMac(y, x, nx, (BLlimb)(n - 1));
+    lAddTo(y, na + 2, q, nq);
+
+    ny = lLen(y, na + 2);
+    lDiv1(y, y, ny, (BLlimb)n);
+    ny = lLen(y, ny);
+
+    //the sequence stops decreasing on the root
+    if (lCmp(y, ny, x, nx) != 2)
+      break;
+
+    sw = x;
+    x = y;
+    y = sw;
+    nx = ny;
+  }
+
+  memcpy(r, x, sizeof(BLlimb) * nx);
+
+  return nx;
+}
+
+/*
+ * lWord.
+ *
+ * Returns the value of a number of, at most, two limbs.
+ */
+static BLdlimb lWord(BLlimb* a, int n) {
+  if (n == 0)
+    return 0;
+
+  if (n == 1)
+    return a[0];
+
+  return (BLdlimb)a[1] * BL_BASE + a[0];
+}
+
+/*
+ * lGcdWord.
+ *
+ * Binary GCD of two words.
+ */
+static BLdlimb lGcdWord(BLdlimb u, BLdlimb v) {
+  BLdlimb t;
+  int s = 0;
+
+  if (u == 0)
+    return v;
+
+  if (v == 0)
+    return u;
+
+  //common powers of 2
+  for (; ((u | v) & 1) == 0; s++) {
+    u >>= 1;
+    v >>= 1;
+  }
+
+  while ((u & 1) == 0)
+    u >>= 1;
+
+  //both odd: the difference is even
+  do {
+    while ((v & 1) == 0)
+      v >>= 1;
+
+    if (u > v) {
+      t = v;
+      v = u;
+      u = t;
+    }
+
+    v -= u;
+  } while (v != 0);
+
+  return u << s;
+}
+
+/*
+ * lLehmer.
+ *
+ * Lehmer step (Knuth, algorithm L). Runs Euclid over the two leading limbs of u and v (nu >= 2,
+ * nv >= nu - 1) while the quotients are surely the same as the ones of the whole numbers, and
+ * the cofactors fit on a limb. Leaves the cofactors on m ({A, B, C, D}, so that A * u + B * v and
+ * C * u + D * v are the numbers after those steps) and returns the number of steps.
+ */
+static int lLehmer(BLlimb* u, int nu, BLlimb* v, int nv, long long* m) {
+  long long uh = (long long)u[nu - 1] * BL_BASE + u[nu - 2];
+  long long vh = (nv == nu ? (long long)v[nu - 1] * BL_BASE : 0) + (nv >= nu - 1 ? v[nu - 2] : 0);
+  long long a = 1;
+  long long b = 0;
+  long long c = 0;
+  long long d = 1;
+  long long q;
+  long long t;
+  long long tc;
+  long long td;
+  int k = 0;
+
+  while (vh + c != 0 && vh + d != 0) {
+    q = (uh + a) / (vh + c);
+
+    if (q >= BL_BASE || q != (uh + b) / (vh + d))
+      break;
+
+    tc = a - q * c;
+    td = b - q * d;
+
+    if (tc <= -(long long)BL_BASE || tc >= BL_BASE || td <= -(long long)BL_BASE || td >= BL_BASE)
+      break;
+
+    a = c;
+    c = tc;
+    b = d;
+    d = td;
+
+    t = uh - q * vh;
+    uh = vh;
+    vh = t;
+
+    ++k;
+  }
+
+  m[0] = a;
+  m[1] = b;
+  m[2] = c;
+  m[3] = d;
+
+  return k;
+}
+
+/*
+ * lLinSub.
+ *
+ * Performs r = x * kx - y * ky, being the result non negative. r has n + 1 limbs (nx, ny <= n).
+ */
+static void lLinSub(BLlimb* r, int n, BLlimb* x, int nx, BLlimb kx, BLlimb* y, int ny, BLlimb ky) {
+  memset(r, 0, sizeof(BLlimb) * (n + 1));
+
+  r[nx] = lMac(r, x, nx, kx);
+  lSub1(r + ny, r + ny, n + 1 - ny, lMsb(r, y, ny, ky));
+}
+
+/*
+ * lLinAdd.
+ *
+ * Performs r = x * kx + y * ky. r has n + 2 limbs (nx, ny <= n).
+ */
+static void lLinAdd(BLlimb* r, int n, BLlimb* x, int nx, BLlimb kx, BLlimb* y, int ny, BLlimb ky) {
+  memset(r, 0, sizeof(BLlimb) * (n + 2));
+
+  r[nx] = lMac(r, x, nx, kx);
+  lAdd1(r + ny, r + ny, n + 2 - ny, lMac(r, y, ny, ky));
+}
+
+/*
+ * lXgcdScratch.
+ *
+ * Returns the working limbs lXgcd needs for operands up to n limbs.
+ */
+static int lXgcdScratch(int n) {
+  int s = lDivScratch(2 * n + 2, n);
+  int t = lScratch(n + 2);
+
+  return 8 * (n + 2) + (s > t ? s : t);
+}
+
+/*
+ * lGcdScratch.
+ *
+ * Returns the working limbs lGcd, lXgcd and lModInv need for operands up to n limbs.
+ */
+int lGcdScratch(int n) {
+  return 3 * (n + 2) + lXgcdScratch(n);
+}
+
+/*
+ * lXgcd.
+ *
+ * Extended GCD: g = gcd(a, b) = x * a + y * b. Returns the limbs of g.
+ *
+ * Large numbers are reduced with Lehmer steps (double limb approximations, so every step goes
+ * ahead about one limb with linear work), and with a division when a step can't be made.
+ * Only the cofactor of a is kept along (their signs alternate); y is got at the end as
+ * (g - x * a) / b. If x is NULL, no cofactor is calculated and the last two limbs are made
+ * with binary GCD.
+ *
+ * x gets nx limbs (up to nb) and its sign on sx (0 or -1); y gets ny limbs (up to na + 1), with
+ * the opposite sign of x (positive if x is 0). y can be NULL. "scr" has lGcdScratch(max(na, nb)) limbs.
+ */
+int lXgcd(BLlimb* g, BLlimb* x, int* nx, char* sx, BLlimb* y, int* ny, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  int n = na > nb ? na : nb;
+  int w = n + 2;
+  BLlimb* u = scr;
+  BLlimb* v = u + w;
+  BLlimb* t = v + w;
+  BLlimb* q = t + w;
+  BLlimb* su = q + w;
+  BLlimb* sv = su + w;
+  BLlimb* st = sv + w;
+  BLlimb* sx2 = st + w;
+  BLlimb* next = sx2 + w;
+  BLlimb* p;
+  long long m[4];
+  char sg = 0;
+  int nu;
+  int nv;
+  int nt;
+  int nq;
+  int nsu = 1;
+  int nsv = 0;
+  int ns;
+  int k;
+  BLdlimb d;
+
+  na = lLen(a, na);
+  nb = lLen(b, nb);
+  nu = na;
+  nv = nb;
+
+  memcpy(u, a, sizeof(BLlimb) * na);
+  memcpy(v, b, sizeof(BLlimb) * nb);
+
+  su[0] = 1;
+
+  //work with u >= v. Then, the cofactor of a is on v
+  if (lCmp(u, nu, v, nv) == 2) {
+    p = u;
+    u = v;
+    v = p;
+
+    p = su;
+    su = sv;
+    sv = p;
+
+    nu = nb;
+    nv = na;
+    nsu = 0;
+    nsv = 1;
+    sg = -1;
+  }
+
+  while (nv > 0) {
+    //small numbers: binary GCD
+    if (x == NULL && nu <= 2) {
+      d = lGcdWord(lWord(u, nu), lWord(v, nv));
+
+      for (nu = 0; d > 0; d /= BL_BASE)
+        u[nu++] = (BLlimb)(d % BL_BASE);
+
+      break;
+    }
+
+    k = 0;
+
+    if (nu >= 2 && nv >= nu - 1)
+      k = lLehmer(u, nu, v, nv, m);
+
+    if (k == 0) {
+      //division step: (u, v) = (v, u % v), and the cofactor of the remainder is su + q * sv
+      lDivRem(q, t, u, nu, v, nv, next);
+
+      nq = lLen(q, nu - nv + 1);
+      nt = lLen(t, nv);
+
+      if (x != NULL) {
+        ns = 0;
+
+        if (nsv > 0 && nq > 0) {
+          lMul(st, q, nq, sv, nsv, next);
+          ns = nq + nsv;
+        }
+
+        memset(st + ns, 0, sizeof(BLlimb) * (w - ns));
+        lAdd1(st + nsu, st + nsu, w - nsu, lAdc(st, st, su, nsu, 0));
+
+        p = su;
+        su = sv;
+        sv = st;
+        st = p;
+
+        nsu = nsv;
+        nsv = lLen(sv, w);
+        sg = -1 - sg;
+      }
+
+      p = u;
+      u = v;
+      v = t;
+      t = p;
+
+      nu = nv;
+      nv = nt;
+    } else {
+      //apply the steps: u = A * u + B * v, v = C * u + D * v (A, B and C, D have opposite signs,
+      //or one of them is 0)
+      if (m[0] >= 0 && m[1] <= 0)
+        lLinSub(t, nu, u, nu, (BLlimb)m[0], v, nv, (BLlimb)-m[1]);
+      else
+        lLinSub(t, nu, v, nv, (BLlimb)m[1], u, nu, (BLlimb)-m[0]);
+
+      if (m[3] >= 0 && m[2] <= 0)
+        lLinSub(q, nu, v, nv, (BLlimb)m[3], u, nu, (BLlimb)-m[2]);
+      else
+        lLinSub(q, nu, u, nu, (BLlimb)m[2], v, nv, (BLlimb)-m[3]);
+
+      //cofactors add their magnitudes
+      if (x != NULL) {
+        ns = nsu > nsv ? nsu : nsv;
+
+        lLinAdd(st, ns, su, nsu, (BLlimb)(m[0] < 0 ? -m[0] : m[0]), sv, nsv, (BLlimb)(m[1] < 0 ? -m[1] : m[1]));
+        lLinAdd(sx2, ns, su, nsu, (BLlimb)(m[2] < 0 ? -m[2] : m[2]), sv, nsv, (BLlimb)(m[3] < 0 ? -m[3] : m[3]));
+
+        p = su;
+        su = st;
+        st = p;
+
+        p = sv;
+        sv = sx2;
+        sx2 = p;
+
+        nsu = lLen(su, ns + 2);
+        nsv = lLen(sv, ns + 2);
+
+        if ((k & 1) == 1)
+          sg = -1 - sg;
+      }
+
+      p = u;
+      u = t;
+      t = p;
+
+      p = v;
+      v = q;
+      q = p;
+
+      nv = lLen(v, nu + 1);
+      nu = lLen(u, nu + 1);
+    }
+  }
+
+  memcpy(g, u, sizeof(BLlimb) * nu);
+
+  if (x == NULL)
+    return nu;
+
+  memcpy(x, su, sizeof(BLlimb) * nsu);
+  *nx = nsu;
+  *sx = nsu == 0 ? 0 : sg;
+
+  if (y == NULL)
+    return nu;
+
+  //y = (g - x * a) / b, exact
+  if (nb == 0) {
+    *ny = 0;
+    return nu;
+  }
+
+  p = scr;
+  t = scr + 2 * w;
+  q = t + 2 * w;
+  ns = nsu + na;
+
+  memset(p, 0, sizeof(BLlimb) * (2 * w));
+
+  if (nsu > 0 && na > 0)
+    lMul(p, x, nsu, a, na, next);
+
+  ns = lLen(p, ns);
+
+  if (*sx == -1) {
+    //g + |x| * a
+    if (ns < nu)
+      ns = nu;
+
+    p[ns] = lAdd1(p + nu, p + nu, ns - nu, lAdc(p, p, g, nu, 0));
+    ++ns;
+  } else if (lCmp(p, ns, g, nu) != 2) {
+    //-(|x| * a - g)
+    lSub1(p + nu, p + nu, ns - nu, lSbb(p, p, g, nu, 0));
+  } else {
+    //g - |x| * a
+    memcpy(t, g, sizeof(BLlimb) * nu);
+    lSub1(t + ns, t + ns, nu - ns, lSbb(t, t, p, ns, 0));
+    memcpy(p, t, sizeof(BLlimb) * nu);
+    ns = nu;
+  }
+
+  ns = lLen(p, ns);
+
+  if (ns < nb)
+    *ny = 0;
+  else {
+    lDivRem(y, q, p, ns, b, nb, next);
+    *ny = lLen(y, ns - nb + 1);
+  }
+
+  return nu;
+}
+
+/*
+ * lGcd.
+ *
+ * Performs g = gcd(a, b). Returns the limbs of g (0 if both are 0).
+ * "scr" has lGcdScratch(max(na, nb)) limbs.
+ */
+int lGcd(BLlimb* g, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  return lXgcd(g, NULL, NULL, NULL, NULL, NULL, a, na, b, nb, scr);
+}
+
+/*
+ * lModInv.
+ *
+ * Performs r = a^-1 mod n. Returns the limbs of r, or -1 if a has no inverse.
+ * r has nn + 2 limbs and "scr" has lGcdScratch(max(na, nn)) limbs.
+ */
+int lModInv(BLlimb* r, BLlimb* a, int na, BLlimb* n, int nn, BLlimb* scr) {
+  int w = (na > nn ? na : nn) + 2;
+  BLlimb* ra = scr;
+  BLlimb* qa = ra + w;
+  BLlimb* g = qa + w;
+  int nr;
+  int ng;
+  char sx;
+
+  na = lLen(a, na);
+  nn = lLen(n, nn);
+
+  if (nn == 0)
+    return -1;
+
+  //a % n
+  if (na >= nn)
+    lDivRem(qa, ra, a, na, n, nn, g + w);
+  else
+    memcpy(ra, a, sizeof(BLlimb) * na);
+
+  na = lLen(ra, na < nn ? na : nn);
+
+  //everything is 0 mod 1
+  if (nn == 1 && n[0] == 1)
+    return 0;
+
+  ng = lXgcd(g, r, &nr, &sx, NULL, NULL, ra, na, n, nn, g + w);
+
+  //a and n shall be coprime
+  if (ng != 1 || g[0] != 1)
+    return -1;
+
+  //x < 0: r = n - |x|
+  if (sx == -1) {
+    memset(r + nr, 0, sizeof(BLlimb) * (nn - nr));
+    lSbb(r, n, r, nn, 0);
+    nr = lLen(r, nn);
+  }
+
+  return nr;
+}
+
+//lPrimes: odd primes below 2048, for trial division and sieving
+static const unsigned short lPrimes[BL_PRIMES] = {
+  3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59,
+  61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131, 137,
+  139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223, 227,
+  229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281, 283, 293, 307, 311, 313,
+  317, 331, 337, 347, 349, 353, 359, 367, 373, 379, 383, 389, 397, 401, 409, 419,
+  421, 431, 433, 439, 443, 449, 457, 461, 463, 467, 479, 487, 491, 499, 503, 509,
+  521, 523, 541, 547, 557, 563, 569, 571, 577, 587, 593, 599, 601, 607, 613, 617,
+  619, 631, 641, 643, 647, 653, 659, 661, 673, 677, 683, 691, 701, 709, 719, 727,
+  733, 739, 743, 751, 757, 761, 769, 773, 787, 797, 809, 811, 821, 823, 827, 829,
+  839, 853, 857, 859, 863, 877, 881, 883, 887, 907, 911, 919, 929, 937, 941, 947,
+  953, 967, 971, 977, 983, 991, 997, 1009, 1013, 1019, 1021, 1031, 1033, 1039, 1049, 1051,
+  1061, 1063, 1069, 1087, 1091, 1093, 1097, 1103, 1109, 1117, 1123, 1129, 1151, 1153, 1163, 1171,
+  1181, 1187, 1193, 1201, 1213, 1217, 1223, 1229, 1231, 1237, 1249, 1259, 1277, 1279, 1283, 1289,
+  1291, 1297, 1301, 1303, 1307, 1319, 1321, 1327, 1361, 1367, 1373, 1381, 1399, 1409, 1423, 1427,
+  1429, 1433, 1439, 1447, 1451, 1453, 1459, 1471, 1481, 1483, 1487, 1489, 1493, 1499, 1511, 1523,
+  1531, 1543, 1549, 1553, 1559, 1567, 1571, 1579, 1583, 1597, 1601, 1607, 1609, 1613, 1619, 1621,
+  1627, 1637, 1657, 1663, 1667, 1669, 1693, 1697, 1699, 1709, 1721, 1723, 1733, 1741, 1747, 1753,
+  1759, 1777, 1783, 1787, 1789, 1801, 1811, 1823, 1831, 1847, 1861, 1867, 1871, 1873, 1877, 1879,
+  1889, 1901, 1907, 1913, 1931, 1933, 1949, 1951, 1973, 1979, 1987, 1993, 1997, 1999, 2003, 2011,
+  2017, 2027, 2029, 2039
+};
+
+/*
+ * lMod1.
+ *
+ * Returns a mod d (n limbs, d > 0), without writing the quotient.
+ */
+static BLlimb lMod1(BLlimb* a, int n, BLlimb d) {
+  int i = n - 1;
+  BLdlimb c = 0;
+
+  for (; i >= 0; i--)
+    c = (c * BL_BASE + a[i]) % d;
+
+  return (BLlimb)c;
+}
+
+/*
+ * lOddPart.
+ *
+ * Performs e = e / 2^s, with s as big as possible (e > 0). Returns s and updates ne.
+ * As BL_BASE is a multiple of 2^9, the lower limb tells up to 9 bits at once.
+ */
+static int lOddPart(BLlimb* e, int* ne) {
+  int s = 0;
+  int z;
+
+  while (e[0] % 2 == 0) {
+    for (z = 1; z < 9 && (e[0] >> z) % 2 == 0; z++);
+
+    lDiv1(e, e, *ne, 1u << z);
+    *ne = lLen(e, *ne);
+    s += z;
+  }
+
+  return s;
+}
+
+/*
+ * lJacobi.
+ *
+ * Returns the Jacobi symbol (a / n), n odd and positive.
+ */
+static int lJacobi(long long a, long long n) {
+  int j = 1;
+  long long t;
+
+  a %= n;
+
+  if (a < 0)
+    a += n;
+
+  while (a != 0) {
+    while (a % 2 == 0) {
+      a /= 2;
+
+      if (n % 8 == 3 || n % 8 == 5)
+        j = -j;
+    }
+
+    t = a;
+    a = n;
+    n = t;
+
+    if (a % 4 == 3 && n % 4 == 3)
+      j = -j;
+
+    a %= n;
+  }
+
+  return n == 1 ? j : 0;
+}
+
+/*
+ * lModAdd.
+ *
+ * Performs r = a + b mod n (k limbs, a and b below n).
+ */
+static void lModAdd(BLlimb* r, BLlimb* a, BLlimb* b, BLlimb* n, int k) {
+  if (lAdc(r, a, b, k, 0) != 0 || lCmp(r, k, n, k) != 2)
+    lSbb(r, r, n, k, 0);
+}
+
+/*
+ * lModSub.
+ *
+ * Performs r = a - b mod n (k limbs, a and b below n).
+ */
+static void lModSub(BLlimb* r, BLlimb* a, BLlimb* b, BLlimb* n, int k) {
+  if (lSbb(r, a, b, k, 0) != 0)
+    lAdc(r, r, n, k, 0);
+}
+
+/*
+ * lModHalf.
+ *
+ * Performs r = r / 2 mod n (n odd). r has room for k + 1 limbs. On Montgomery form it is
+ * the same operation, as (x * R) / 2 = (x / 2) * R.
+ */
+static void lModHalf(BLlimb* r, BLlimb* n, int k) {
+  r[k] = 0;
+
+  if (r[0] % 2 == 1)
+    r[k] = lAdc(r, r, n, k, 0);
+
+  lDiv1(r, r, k + 1, 2);
+}
+
+/*
+ * lMontSmall.
+ *
+ * Moves a small signed value into Montgomery form: r = v * R mod n.
+ */
+static void lMontSmall(BLlimb* r, long long v, BLmont* c, BLlimb* scr) {
+  BLlimb t = (BLlimb)(v < 0 ? -v : v);
+
+  lMontTo(r, &t, 1, c, scr);
+
+  if (v < 0 && lLen(r, c->k) > 0)
+    lSbb(r, c->n, r, c->k, 0);
+}
+
+/*
+ * lStrongPrp.
+ *
+ * Miller-Rabin round: returns 1 if n (the modulus of the context) is a strong probable prime to
+ * base b. n - 1 = d * 2^s, and m1 is -1 on Montgomery form (n - R mod n).
+ */
+static int lStrongPrp(BLlimb b, BLlimb* d, int nd, int s, BLlimb* m1, BLmont* c, BLlimb* scr) {
+  int k = c->k;
+  int i = 1;
+  BLlimb* x = scr;
+  BLlimb* y = x + k;
+  BLlimb* next = y + k;
+
+  lMontTo(x, &b, 1, c, next);
+  lMontPow(y, x, d, nd, c, next);
+
+  if (memcmp(y, c->one, sizeof(BLlimb) * k) == 0 || memcmp(y, m1, sizeof(BLlimb) * k) == 0)
+    return 1;
+
+  for (; i < s; i++) {
+    lMontMul(y, y, y, c, next);
+
+    if (memcmp(y, m1, sizeof(BLlimb) * k) == 0)
+      return 1;
+
+    //1 without passing by -1: there's a non trivial root of 1
+    if (memcmp(y, c->one, sizeof(BLlimb) * k) == 0)
+      return 0;
+  }
+
+  return 0;
+}
+
+/*
+ * lSquare.
+ *
+ * Returns 1 if a (na limbs, na > 0) is a perfect square.
+ */
+static int lSquare(BLlimb* a, int na, BLlimb* scr) {
+  BLlimb* r = scr;
+  BLlimb* q = r + na + 1;
+  BLlimb* next = q + 2 * na + 2;
+  int nr = lRoot(r, a, na, 2, next);
+
+  lSqr(q, r, nr, next);
+
+  return lCmp(q, 2 * nr, a, na) == 0;
+}
+
+/*
+ * lStrongLucas.
+ *
+ * Strong Lucas test with Selfridge's parameters: D is the first of 5, -7, 9, -11... with
+ * (D / n) = -1, P = 1 and Q = (1 - D) / 4. n + 1 = d * 2^s, and n is a strong Lucas probable prime
+ * if U(d) = 0 or V(d * 2^r) = 0 for some r < s. Returns 1 if it is.
+ *
+ * The sequences are walked over the bits of d with U(2k) = U(k) * V(k), V(2k) = V(k)^2 - 2 * Q^k,
+ * U(k + 1) = (U(2k) + V(2k)) / 2 and V(k + 1) = (D * U(2k) + V(2k)) / 2, on Montgomery form.
+ */
+static int lStrongLucas(BLmont* c, BLlimb* scr) {
+  int k = c->k;
+  int w = k + 1;
+  int ne = k + 1;
+  int nw = 0;
+  int bits;
+  int s;
+  int j;
+  long long dd = 5;
+  long long ad;
+  BLlimb* n = c->n;
+  BLlimb* e = scr;
+  BLlimb* bw = e + w;
+  BLlimb* u = bw + 2 * w;
+  BLlimb* v = u + w;
+  BLlimb* t = v + w;
+  BLlimb* z = t + w;
+  BLlimb* qk = z + w;
+  BLlimb* dm = qk + w;
+  BLlimb* qm = dm + w;
+  BLlimb* next = qm + w;
+
+  //D: (|D| / n) goes to (n mod |D| / |D|) by reciprocity, and there's a -1 for D < 0 if n = 3 mod 4
+  //(n mod 4 is on the lower limb, as BL_BASE = 0 mod 4)
+  for (;; dd = dd > 0 ? -dd - 2 : -dd + 2) {
+    ad = dd < 0 ? -dd : dd;
+    j = lJacobi(lMod1(n, k, (BLlimb)ad), ad);
+
+    if (n[0] % 4 == 3 && (ad % 4 == 3) != (dd < 0))
+      j = -j;
+
+    if (j == -1)
+      break;
+
+    //a factor of D (n is bigger than any D reached)
+    if (j == 0)
+      return 0;
+
+    //there's no such D for squares
+    if (dd == 13 && lSquare(n, k, next) == 1)
+      return 0;
+  }
+
+  lMontSmall(dm, dd, c, next);
+  lMontSmall(qm, (1 - dd) / 4, c, next);
+
+  //n + 1 = d * 2^s, and d on binary words
+  memcpy(e, n, sizeof(BLlimb) * k);
+  e[k] = lAdd1(e, e, k, 1);
+  ne = lLen(e, ne);
+  s = lOddPart(e, &ne);
+
+  while (ne > 0) {
+    bw[nw++] = lDiv1(e, e, ne, 1u << BL_BITS);
+    ne = lLen(e, ne);
+  }
+
+  bits = nw * BL_BITS;
+
+  while (bits > 0 && lBit(bw, bits - 1) == 0)
+    --bits;
+
+  //U(1) = 1, V(1) = P = 1
+  memcpy(u, c->one, sizeof(BLlimb) * k);
+  memcpy(v, c->one, sizeof(BLlimb) * k);
+  memcpy(qk, qm, sizeof(BLlimb) * k);
+
+  for (bits -= 2; bits >= 0; bits--) {
+    lMontMul(u, u, v, c, next);
+    lMontMul(v, v, v, c, next);
+    lModSub(v, v, qk, n, k);
+    lModSub(v, v, qk, n, k);
+    lMontMul(qk, qk, qk, c, next);
+
+    if (lBit(bw, bits) == 1) {
+      lModAdd(t, u, v, n, k);
+      lModHalf(t, n, k);
+
+      lMontMul(z, dm, u, c, next);
+      lModAdd(z, z, v, n, k);
+      lModHalf(z, n, k);
+
+      memcpy(u, t, sizeof(BLlimb) * k);
+      memcpy(v, z, sizeof(BLlimb) * k);
+      lMontMul(qk, qk, qm, c, next);
+    }
+  }
+
+  if (lLen(u, k) == 0 || lLen(v, k) == 0)
+    return 1;
+
+  for (j = 1; j < s; j++) {
+    lMontMul(v, v, v, c, next);
+    lModSub(v, v, qk, n, k);
+    lModSub(v, v, qk, n, k);
+
+    if (lLen(v, k) == 0)
+      return 1;
+
+    lMontMul(qk, qk, qk, c, next);
+  }
+
+  return 0;
+}
+
+/*
+ * lPrp.
+ *
+ * Probable prime test for a (k limbs, odd, without factors on the trial table): Baillie-PSW
+ * (Miller-Rabin to base 2 and strong Lucas test), and "rounds" more Miller-Rabin rounds to
+ * bases 3, 5, 7... There's no known Baillie-PSW pseudoprime, so the extra rounds are optional.
+ */
+static int lPrp(BLlimb* a, int k, int rounds, BLlimb* scr) {
+  BLmont* c = (BLmont*)scr;
+  BLlimb* d = scr + BL_MONT_LIMBS;
+  BLlimb* m1 = d + k;
+  BLlimb* next = m1 + k;
+  int nd = k;
+  int s;
+  int i = 0;
+
+  lMontInit(c, a, k, next);
+
+  //n - 1 = d * 2^s, and -1 on Montgomery form
+  lSub1(d, a, k, 1);
+  s = lOddPart(d, &nd);
+  lSbb(m1, c->n, c->one, k, 0);
+
+  if (lStrongPrp(2, d, nd, s, m1, c, next) == 0 || lStrongLucas(c, next) == 0)
+    return 0;
+
+  for (; i < rounds && i < BL_PRIMES; i++)
+    if (lStrongPrp(lPrimes[i], d, nd, s, m1, c, next) == 0)
+      return 0;
+
+  return 1;
+}
+
+/*
+ * lPrimeScratch.
+ *
+ * Returns the working limbs lIsPrime and lPrimeSieve need for numbers up to n limbs (the
+ * candidates of a sieve can take one more).
+ */
+int lPrimeScratch(int n) {
+  int k = n + 1;
+  int s = lMontScratch(k, k) + 2 * k;
+  int t = lRootScratch(k) + 3 * k + 3;
+
+  if (t > s)
+    s = t;
+
+  //sieve candidate, Montgomery context, d and -1, and the Lucas sequences
+  return (n + 2) + BL_MONT_LIMBS + 2 * k + 11 * (k + 1) + s;
+}
+
+/*
+ * lIsPrime.
+ *
+ * Returns 1 if a (na limbs, up to L_MAX_LENGTH - 1) is prime or a probable prime, and 0 otherwise.
+ * Factors up to 2039 are found by trial division (so the answer is exact below 2039^2), and
+ * the rest goes through Baillie-PSW and "rounds" more Miller-Rabin rounds.
+ * "scr" is a working buffer of lPrimeScratch(na) limbs.
+ */
+int lIsPrime(BLlimb* a, int na, int rounds, BLlimb* scr) {
+  int i = 0;
+
+  na = lLen(a, na);
+
+  if (na == 0 || (na == 1 && a[0] < 2))
+    return 0;
+
+  if (a[0] % 2 == 0)
+    return na == 1 && a[0] == 2;
+
+  for (; i < BL_PRIMES; i++)
+    if (lMod1(a, na, lPrimes[i]) == 0)
+      return na == 1 && a[0] == lPrimes[i];
+
+  if (na == 1 && a[0] < (BLlimb)lPrimes[BL_PRIMES - 1] * lPrimes[BL_PRIMES - 1])
+    return 1;
+
+  return lPrp(a, na, rounds, scr);
+}
+
+/*
+ * lSieveMark.
+ *
+ * Clears res[i] for the multiples a + i of p (but p itself) on the range of lPrimeSieve.
+ */
+static void lSieveMark(char* res, int len, BLlimb* a, int na, BLlimb p) {
+  BLlimb r = lMod1(a, na, p);
+  BLlimb a0 = na > 0 ? a[0] : 0;
+  int i = r == 0 ? 0 : (int)(p - r);
+
+  for (; i < len; i += (int)p)
+    if (na > 1 || a0 + (BLlimb)i != p)
+      res[i] = 0;
+}
+
+/*
+ * lPrimeSieve.
+ *
+ * Tests a, a + 1, ..., a + len - 1 (a has na limbs) and leaves on res[i] if a + i is prime or a
+ * probable prime (1) or not (0). Returns how many of them are. The range is sieved first (one
+ * division by prime for the whole range), and only the remaining candidates go through lIsPrime's
+ * tests. Besides the trial table, primes up to len * na^2 (and BL_SIEVE_MAX) are sieved, as every
+ * one of them costs na limb divisions and saves about len / p tests of na^3 order.
+ * "scr" is a working buffer of lPrimeScratch(na) limbs.
+ */
+int lPrimeSieve(char* res, BLlimb* a, int na, int len, int rounds, BLlimb* scr) {
+  BLlimb* x = scr;
+  BLlimb* next = x + na + 2;
+  char seg[BL_SIEVE_SEGMENT];
+  long long lim;
+  long long lo;
+  long long f;
+  BLlimb a0;
+  BLlimb p;
+  int nx;
+  int i;
+  int j = 0;
+  int cnt = 0;
+
+  na = lLen(a, na);
+  a0 = na > 0 ? a[0] : 0;
+  memset(res, 1, len);
+
+  //evens, and then the multiples of every prime of the table
+  for (i = (int)(a0 % 2); i < len; i += 2)
+    res[i] = 0;
+
+  for (; j < BL_PRIMES; j++)
+    lSieveMark(res, len, a, na, lPrimes[j]);
+
+  //primes above the table, by segments of odd numbers (the table sieves them, as they're below 2053^2)
+  lim = (long long)len * na * na;
+
+  if (lim > BL_SIEVE_MAX)
+    lim = BL_SIEVE_MAX;
+
+  for (lo = 2049; lo < lim; lo += 2 * BL_SIEVE_SEGMENT) {
+    memset(seg, 1, BL_SIEVE_SEGMENT);
+
+    for (j = 0; j < BL_PRIMES && (long long)lPrimes[j] * lPrimes[j] < lo + 2 * BL_SIEVE_SEGMENT; j++) {
+      p = lPrimes[j];
+      f = (lo + p - 1) / p * p;
+
+      if (f % 2 == 0)
+        f += p;
+
+      for (; f < lo + 2 * BL_SIEVE_SEGMENT; f += 2 * p)
+        seg[(f - lo) / 2] = 0;
+    }
+
+    for (i = 0; i < BL_SIEVE_SEGMENT && lo + 2 * i < lim; i++)
+      if (seg[i] == 1)
+        lSieveMark(res, len, a, na, (BLlimb)(lo + 2 * i));
+  }
+
+  //0, 1 and 2
+  for (i = 0; na <= 1 && i < len && a0 + (BLlimb)i <= 2; i++)
+    res[i] = a0 + (BLlimb)i == 2;
+
+  //x runs through the range. Below 2039^2, the sieve is exact
+  memset(x, 0, sizeof(BLlimb) * (na + 1));
+  memcpy(x, a, sizeof(BLlimb) * na);
+  j = 0;
+
+  for (i = 0; i < len; i++) {
+    if (res[i] == 0)
+      continue;
+
+    lAdd1(x, x, na + 1, (BLlimb)(i - j));
+    j = i;
+    nx = lLen(x, na + 1);
+
+    if (nx > 1 || x[0] >= (BLlimb)lPrimes[BL_PRIMES - 1] * lPrimes[BL_PRIMES - 1])
+      res[i] = (char)lPrp(x, nx, rounds, next);
+
+    cnt += res[i];
+  }
+
+  return cnt;
+}
+
+/*
+ * lAccInit.
+ *
+ * Sets the accumulator to 0.
+ */
+void lAccInit(BLacc* c) {
+  memset(c, 0, sizeof(BLacc));
+}
+
+/*
+ * lAccAdd.
+ *
+ * Performs c += a (or c -= a if sig is -1) over na limbs, with no carry. Returns 1 if a doesn't
+ * fit on the accumulator.
+ */
+int lAccAdd(BLacc* c, BLlimb* a, int na, int sig) {
+  int i = 0;
+  long long* n = c->n;
+
+  na = lLen(a, na);
+
+  if (na > BL_ACC_LIMBS)
+    return 1;
+
+  if (c->pend + 1 > BL_ACC_MAX && lAccNorm(c) == 1)
+    return 1;
+
+  if (sig == -1)
+    for (; i < na; i++)
+      n[i] -= a[i];
+  else
+    for (; i < na; i++)
+      n[i] += a[i];
+
+  if (na > c->k)
+    c->k = na;
+
+  ++c->pend;
+
+  return 0;
+}
+
+/*
+ * lLanes.
+ *
+ * Performs l += d (or l -= d if sub is 1) over n digit lanes, being d decimal digits (0..9).
+ */
+static void lLanes(int* l, const signed char* d, int n, int sub) {
+  int i = 0;
+
+  if (sub == 1)
+    for (; i < n; i++)
+      l[i] -= d[i];
+  else
+    for (; i < n; i++)
+      l[i] += d[i];
+}
+
+#if BL_X86 == 1
+/*
+ * lLanesSse2.
+ *
+ * SSE2 version of lLanes, on blocks of 16 digits (widened to 32 bits with two unpacks).
+ */
+BL_SSE2_FN static void lLanesSse2(int* l, const signed char* d, int n, int sub) {
+  const __m128i zero = _mm_setzero_si128();
+  int i = 0;
+  int j;
+  __m128i x;
+  __m128i w[4];
+
+  for (; i + 16 <= n; i += 16) {
+    x = _mm_loadu_si128((__m128i*)(d + i));
+    w[0] = _mm_unpacklo_epi8(x, zero);
+    w[2] = _mm_unpackhi_epi8(x, zero);
+    w[1] = _mm_unpackhi_epi16(w[0], zero);
+    w[0] = _mm_unpacklo_epi16(w[0], zero);
+    w[3] = _mm_unpackhi_epi16(w[2], zero);
+    w[2] = _mm_unpacklo_epi16(w[2], zero);
+
+    for (j = 0; j < 4; j++) {
+      x = _mm_loadu_si128((__m128i*)(l + i + 4 * j));
+      x = sub == 1 ? _mm_sub_epi32(x, w[j]) : _mm_add_epi32(x, w[j]);
+      _mm_storeu_si128((__m128i*)(l + i + 4 * j), x);
+    }
+  }
+
+  lLanes(l + i, d + i, n - i, sub);
+}
+
+/*
+ * lLanesAvx2.
+ *
+ * AVX2 version of lLanes, on blocks of 8 digits.
+ */
+BL_AVX2_FN static void lLanesAvx2(int* l, const signed char* d, int n, int sub) {
+  int i = 0;
+  __m256i w;
+  __m256i x;
+
+  for (; i + 8 <= n; i += 8) {
+    w = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(d + i)));
+    x = _mm256_loadu_si256((__m256i*)(l + i));
+    x = sub == 1 ? _mm256_sub_epi32(x, w) : _mm256_add_epi32(x, w);
+    _mm256_storeu_si256((__m256i*)(l + i), x);
+  }
+
+  lLanes(l + i, d + i, n - i, sub);
+}
+
+/*
+ * lLanesAvx512.
+ *
+ * AVX-512 version of lLanes, on blocks of 16 digits.
+ */
+BL_AVX512_FN static void lLanesAvx512(int* l, const signed char* d, int n, int sub) {
+  int i = 0;
+  __m512i w;
+  __m512i x;
+
+  for (; i + 16 <= n; i += 16) {
+    w = _mm512_cvtepu8_epi32(_mm_loadu_si128((__m128i*)(d + i)));
+    x = _mm512_loadu_si512((void*)(l + i));
+    x = sub == 1 ? _mm512_sub_epi32(x, w) : _mm512_add_epi32(x, w);
+    _mm512_storeu_si512((void*)(l + i), x);
+  }
+
+  lLanes(l + i, d + i, n - i, sub);
+}
+#endif
+
+/*
+ * lAccDigits.
+ *
+ * Performs c += a (or c -= a if sig is -1) being a the n digits of a BigInteger (least significant
+ * first, only the top one can be negative), that are added to the digit lanes as they are (the
+ * kernel is the one chosen by lDigitSimd). Returns 1 if a doesn't fit on the accumulator.
+ */
+int lAccDigits(BLacc* c, const signed char* a, int n, int sig) {
+  int t;
+
+  if (n > BL_ACC_DIGITS)
+    return 1;
+
+  if (n <= 0)
+    return 0;
+
+  if (c->dpend + 1 > BL_ACC_DMAX && lAccNorm(c) == 1)
+    return 1;
+
+#if BL_X86 == 1
+  t = lDigitLevelGet();
+
+  if (t == BL_AVX512)
+    lLanesAvx512(c->d, a, n - 1, sig == -1);
+  else if (t == BL_AVX2)
+    lLanesAvx2(c->d, a, n - 1, sig == -1);
+  else if (t == BL_SSE2)
+    lLanesSse2(c->d, a, n - 1, sig == -1);
+  else
+#endif
+    lLanes(c->d, a, n - 1, sig == -1);
+
+  //the top digit holds the sign of the number
+  t = a[n - 1] < 0 ? -a[n - 1] : a[n - 1];
+  c->d[n - 1] += sig == -1 ? -t : t;
+
+  if (n > c->kd)
+    c->kd = n;
+
+  ++c->dpend;
+
+  return 0;
+}
+
+/*
+ * lAccMul.
+ *
+ * Performs c += a * b (or c -= a * b if sig is -1). Below ACC_MUL_THRESHOLD limbs every partial
+ * product is split on its low and high limb, that go straight to their lanes (so there's no carry
+ * chain between columns). From it, the product is made by lMul on t (na + nb limbs), with scr as
+ * its scratch (lScratch), and then added. Returns 1 if the product doesn't fit on the accumulator.
+ */
+int lAccMul(BLacc* c, BLlimb* a, int na, BLlimb* b, int nb, int sig, BLlimb* t, BLlimb* scr) {
+  int i = 0;
+  int j;
+  int w;
+  long long* n;
+  BLdlimb p;
+  BLlimb h;
+  BLlimb l;
+
+  na = lLen(a, na);
+  nb = lLen(b, nb);
+
+  if (na == 0 || nb == 0)
+    return 0;
+
+  if (na + nb > BL_ACC_LIMBS)
+    return 1;
+
+  w = na < nb ? na : nb;
+
+  if (w >= ACC_MUL_THRESHOLD) {
+    lMul(t, a, na, b, nb, scr);
+
+    return lAccAdd(c, t, na + nb, sig);
+  }
+
+  //a lane takes a low and a high limb from up to w + 1 rows
+  if (c->pend + 2 * (w + 1) > BL_ACC_MAX && lAccNorm(c) == 1)
+    return 1;
+
+  for (; i < na; i++) {
+    if (a[i] == 0)
+      continue;
+
+    n = c->n + i;
+    h = 0;
+
+    //the high limb of column j is added with the low limb of column j + 1
+    for (j = 0; j < nb; j++) {
+      p = (BLdlimb)a[i] * b[j];
+      l = (BLlimb)(p % BL_BASE);
+
+      if (sig == -1)
+        n[j] -= (long long)l + h;
+      else
+        n[j] += (long long)l + h;
+
+      h = (BLlimb)(p / BL_BASE);
+    }
+
+    if (sig == -1)
+      n[nb] -= h;
+    else
+      n[nb] += h;
+  }
+
+  if (na + nb > c->k)
+    c->k = na + nb;
+
+  c->pend += 2 * (w + 1);
+
+  return 0;
+}
+
+/*
+ * lAccCarry.
+ *
+ * Propagates the carries of the limb lanes: every lane but the top one is left on [0, BL_BASE)
+ * and the top one on (-BL_BASE, BL_BASE), holding the sign. Returns 1 if the carries go over
+ * BL_ACC_LIMBS lanes.
+ */
+static int lAccCarry(BLacc* c) {
+  int i = 0;
+  long long* n = c->n;
+  long long v = 0;
+  long long q;
+
+  if (c->k == 0) {
+    c->pend = 0;
+    return 0;
+  }
+
+  //floor division, so negative lanes borrow from the next one
+  for (; i < c->k - 1; i++) {
+    v += n[i];
+    q = v / (long long)BL_BASE;
+
+    if (v - q * (long long)BL_BASE < 0)
+      --q;
+
+    n[i] = v - q * (long long)BL_BASE;
+    v = q;
+  }
+
+  //truncated division from the top lane, so a negative value stops too
+  v += n[i];
+
+  for (;;) {
+    q = v / (long long)BL_BASE;
+    n[i] = v - q * (long long)BL_BASE;
+
+    if (q == 0)
+      break;
+
+    if (++i == BL_ACC_LIMBS)
+      return 1;
+
+    v = q;
+  }
+
+  for (c->k = i + 1; c->k > 0 && n[c->k - 1] == 0; --c->k)
+    ;
+
+  c->pend = 1;
+
+  return 0;
+}
+
+/*
+ * lAccNorm.
+ *
+ * Folds the digit lanes into the limb lanes (9 digit lanes per limb) and propagates the carries
+ * (see lAccCarry). Returns 1 if the carries go over BL_ACC_LIMBS lanes.
+ */
+int lAccNorm(BLacc* c) {
+  int i = 0;
+  int j;
+  int nd;
+  long long v;
+
+  if (c->kd > 0) {
+    //a limb lane takes up to dpend limbs from the digit lanes
+    if (c->pend + c->dpend > BL_ACC_MAX && lAccCarry(c) == 1)
+      return 1;
+
+    nd = (c->kd + BL_DIGITS - 1) / BL_DIGITS;
+
+    for (; i < nd; i++) {
+      v = 0;
+
+      for (j = BL_DIGITS - 1; j >= 0; j--)
+        v = v * 10 + c->d[i * BL_DIGITS + j];
+
+      c->n[i] += v;
+    }
+
+    memset(c->d, 0, sizeof(int) * nd * BL_DIGITS);
+
+    if (nd > c->k)
+      c->k = nd;
+
+    c->pend += c->dpend;
+    c->kd = 0;
+    c->dpend = 0;
+  }
+
+  return lAccCarry(c);
+}
+
+/*
+ * lAccGet.
+ *
+ * Normalizes the accumulator and moves its absolute value to r (k limbs) and its sign to sig
+ * (0 or -1). The accumulator keeps its value, so it can go on adding. Returns k, or -1 if the
+ * carries go over BL_ACC_LIMBS lanes.
+ */
+int lAccGet(BLlimb* r, char* sig, BLacc* c) {
+  int i = 0;
+  long long* n = c->n;
+
+  if (lAccNorm(c) == 1)
+    return -1;
+
+  *sig = 0;
+
+  //negative: the lanes are negated (the top one is positive then) and normalized again
+  if (c->k > 0 && n[c->k - 1] < 0) {
+    *sig = -1;
+
+    for (; i < c->k; i++)
+      n[i] = -n[i];
+
+    lAccNorm(c);
+  }
+
+  for (i = 0; i < c->k; i++)
+    r[i] = (BLlimb)n[i];
+
+  //back to the value (a lane on (-BL_BASE, 0] is as good as a normalized one)
+  if (*sig == -1)
+    for (i = 0; i < c->k; i++)
+      n[i] = -n[i];
+
+  return c->k;
+}
+
+/*
+ * lAddN.
+ *
+ * Performs r = a + b for magnitudes, na >= nb. Returns the carry.
+ */
+static BLlimb lAddN(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb) {
+  BLlimb c = lAdc(r, a, b, nb, 0);
+
+  return lAdd1(r + nb, a + nb, na - nb, c);
+}
+
+/*
+ * lSubN.
+ *
+ * Performs r = a - b for magnitudes, a >= b.
+ */
+static void lSubN(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb) {
+  BLlimb c = lSbb(r, a, b, nb, 0);
+
+  lSub1(r + nb, a + nb, na - nb, c);
+}
+
+/*
+ * lCpu.
+ *
+ * Returns the vector extensions (BL_CPU_*) that the CPU has and the OS saves.
+ */
+int lCpu() {
+  int ret = 0;
+#if BL_X86 == 1 && defined(_MSC_VER)
+  int r[4];
+  int top;
+  unsigned long long x = 0;
+
+  __cpuid(r, 0);
+  top = r[0];
+  __cpuid(r, 1);
+
+  if ((r[3] & (1 << 26)) != 0)
+    ret |= BL_CPU_SSE2;
+
+  //AVX registers need OSXSAVE and XCR0
+  if ((r[2] & (1 << 27)) != 0)
+    x = _xgetbv(0);
+
+  if (top >= 7) {
+    __cpuidex(r, 7, 0);
+
+    if ((x & 0x6) == 0x6 && (r[1] & (1 << 5)) != 0)
+      ret |= BL_CPU_AVX2;
+
+    if ((x & 0xe6) == 0xe6 && (r[1] & (1 << 16)) != 0)
+      ret |= BL_CPU_AVX512F;
+
+    if ((x & 0xe6) == 0xe6 && (r[1] & (1 << 30)) != 0)
+      ret |= BL_CPU_AVX512BW;
+  }
+#elif BL_X86 == 1
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("sse2"))
+    ret |= BL_CPU_SSE2;
+
+  if (__builtin_cpu_supports("avx2"))
+    ret |= BL_CPU_AVX2;
+
+  if (__builtin_cpu_supports("avx512f"))
+    ret |= BL_CPU_AVX512F;
+
+  if (__builtin_cpu_supports("avx512bw"))
+    ret |= BL_CPU_AVX512BW;
+#endif
+
+  return ret;
+}
+
+/*
+ * lDigitTail.
+ *
+ * Performs r += b (r -= b if sub is 1) over n decimal digits (least significant first, values
+ * 0..9), being c the carry (or borrow) in. Returns the carry out. It's the scalar kernel, and
+ * the vector ones end with it.
+ */
+static int lDigitTail(signed char* r, const signed char* b, int n, int sub, int c) {
+  int s;
+  int i = 0;
+
+  if (sub) {
+    for (; i < n; i++) {
+      s = r[i] - b[i] - c;
+      c = s < 0;
+      r[i] = (signed char)(c == 1 ? s + 10 : s);
+    }
+  } else {
+    for (; i < n; i++) {
+      s = r[i] + b[i] + c;
+      c = s >= 10;
+      r[i] = (signed char)(c == 1 ? s - 10 : s);
+    }
+  }
+
+  return c;
+}
+
+/*
+ * lDigitAddScalar.
+ *
+ * Performs r += b over n digits and returns the carry out. Reference of the vector kernels.
+ */
+int lDigitAddScalar(signed char* r, const signed char* b, int n) {
+  return lDigitTail(r, b, n, 0, 0);
+}
+
+/*
+ * lDigitSubScalar.
+ *
+ * Performs r -= b over n digits and returns the borrow out. Reference of the vector kernels.
+ */
+int lDigitSubScalar(signed char* r, const signed char* b, int n) {
+  return lDigitTail(r, b, n, 1, 0);
+}
+
+#if BL_X86 == 1
+/*
+ * lCarries.
+ *
+ * Carry lookahead over a block of w digits (w <= 64). g has a bit for every digit that makes a
+ * carry by itself (a sum above 9, or a difference below 0) and p one for every digit that only
+ * passes it (9 on add, 0 on sub). Returns a bit for every digit that gets a carry, and moves the
+ * carry out to *c (it comes in on *c too).
+ *
+ * A carry that gets to a run of p bits goes through all of them, so adding the carries to p
+ * leaves the run on 0 and the carry after it; the xor with p gives the run back.
+ */
+static unsigned long long lCarries(unsigned long long g, unsigned long long p, int w, int* c) {
+  unsigned long long x = (g << 1) | (unsigned long long)*c;
+  unsigned long long t = x + p;
+
+  if (w == 64) {
+    *c = (int)(g >> 63) | (t < x);
+
+    return t ^ p;
+  }
+
+  *c = (int)(t >> w) & 1;
+
+  return (t ^ p) & ((1ull << w) - 1);
+}
+
+/*
+ * lSpread.
+ *
+ * Moves the lower 8 bits of m to 8 bytes (0 or 1), bit i to byte i.
+ */
+static long long lSpread(unsigned long long m) {
+  unsigned long long x = ((m & 0xff) * 0x0101010101010101ull) & 0x8040201008040201ull;
+
+  return (long long)(((x + 0x7f7f7f7f7f7f7f7full) >> 7) & 0x0101010101010101ull);
+}
+
+/*
+ * lDigitSse2.
+ *
+ * SSE2 version of lDigitTail, on blocks of 16 digits. Digits are added (or subtracted) at once,
+ * the carries come from lCarries and every digit is normalized once.
+ */
+BL_SSE2_FN static int lDigitSse2(signed char* r, const signed char* b, int n, int sub, int c) {
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i ten = _mm_set1_epi8(10);
+  const __m128i zero = _mm_setzero_si128();
+  unsigned long long m;
+  int i = 0;
+  __m128i s;
+  __m128i v;
+
+  for (; i + 16 <= n; i += 16) {
+    if (sub) {
+      s = _mm_sub_epi8(_mm_loadu_si128((__m128i*)(r + i)), _mm_loadu_si128((__m128i*)(b + i)));
+      m = lCarries((unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi8(zero, s)), (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero)), 16, &c);
+      v = _mm_set_epi64x(lSpread(m >> 8), lSpread(m));
+      s = _mm_sub_epi8(s, v);
+      s = _mm_add_epi8(s, _mm_and_si128(_mm_cmpgt_epi8(zero, s), ten));
+    } else {
+      s = _mm_add_epi8(_mm_loadu_si128((__m128i*)(r + i)), _mm_loadu_si128((__m128i*)(b + i)));
+      m = lCarries((unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi8(s, nine)), (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(s, nine)), 16, &c);
+      v = _mm_set_epi64x(lSpread(m >> 8), lSpread(m));
+      s = _mm_add_epi8(s, v);
+      s = _mm_sub_epi8(s, _mm_and_si128(_mm_cmpgt_epi8(s, nine), ten));
+    }
+
+    _mm_storeu_si128((__m128i*)(r + i), s);
+  }
+
+  return lDigitTail(r + i, b + i, n - i, sub, c);
+}
+
+/*
+ * lDigitAvx2.
+ *
+ * AVX2 version of lDigitTail, on blocks of 32 digits. Carries go to bytes with a shuffle.
+ */
+BL_AVX2_FN static int lDigitAvx2(signed char* r, const signed char* b, int n, int sub, int c) {
+  const __m256i nine = _mm256_set1_epi8(9);
+  const __m256i ten = _mm256_set1_epi8(10);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i bytes = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+  const __m256i bits = _mm256_set1_epi64x((long long)0x8040201008040201ull);
+  unsigned long long m;
+  int i = 0;
+  __m256i s;
+  __m256i v;
+
+  for (; i + 32 <= n; i += 32) {
+    if (sub) {
+      s = _mm256_sub_epi8(_mm256_loadu_si256((__m256i*)(r + i)), _mm256_loadu_si256((__m256i*)(b + i)));
+      m = lCarries((unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(zero, s)), (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, zero)), 32, &c);
+    } else {
+      s = _mm256_add_epi8(_mm256_loadu_si256((__m256i*)(r + i)), _mm256_loadu_si256((__m256i*)(b + i)));
+      m = lCarries((unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(s, nine)), (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, nine)), 32, &c);
+    }
+
+    //byte j gets -1 if bit j of m is set
+    v = _mm256_shuffle_epi8(_mm256_set1_epi32((int)(unsigned int)m), bytes);
+    v = _mm256_cmpeq_epi8(_mm256_and_si256(v, bits), bits);
+
+    if (sub) {
+      s = _mm256_add_epi8(s, v);
+      s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_cmpgt_epi8(zero, s), ten));
+    } else {
+      s = _mm256_sub_epi8(s, v);
+      s = _mm256_sub_epi8(s, _mm256_and_si256(_mm256_cmpgt_epi8(s, nine), ten));
+    }
+
+    _mm256_storeu_si256((__m256i*)(r + i), s);
+  }
+
+  return lDigitTail(r + i, b + i, n - i, sub, c);
+}
+
+/*
+ * lDigitAvx512.
+ *
+ * AVX-512BW version of lDigitTail, on blocks of 64 digits. Compares give the masks straight away.
+ */
+BL_AVX512_FN static int lDigitAvx512(signed char* r, const signed char* b, int n, int sub, int c) {
+  const __m512i nine = _mm512_set1_epi8(9);
+  const __m512i ten = _mm512_set1_epi8(10);
+  const __m512i one = _mm512_set1_epi8(1);
+  const __m512i zero = _mm512_setzero_si512();
+  __mmask64 m;
+  int i = 0;
+  __m512i s;
+
+  for (; i + 64 <= n; i += 64) {
+    if (sub) {
+      s = _mm512_sub_epi8(_mm512_loadu_si512(r + i), _mm512_loadu_si512(b + i));
+      m = lCarries(_mm512_cmpgt_epi8_mask(zero, s), _mm512_cmpeq_epi8_mask(s, zero), 64, &c);
+      s = _mm512_mask_sub_epi8(s, m, s, one);
+      s = _mm512_mask_add_epi8(s, _mm512_cmpgt_epi8_mask(zero, s), s, ten);
+    } else {
+      s = _mm512_add_epi8(_mm512_loadu_si512(r + i), _mm512_loadu_si512(b + i));
+      m = lCarries(_mm512_cmpgt_epi8_mask(s, nine), _mm512_cmpeq_epi8_mask(s, nine), 64, &c);
+      s = _mm512_mask_add_epi8(s, m, s, one);
+      s = _mm512_mask_sub_epi8(s, _mm512_cmpgt_epi8_mask(s, nine), s, ten);
+    }
+
+    _mm512_storeu_si512(r + i, s);
+  }
+
+  return lDigitTail(r + i, b + i, n - i, sub, c);
+}
+#endif
+
+/*
+ * lDigitSimd.
+ *
+ * Returns the widest level of the digit kernels (BL_SCALAR, BL_SSE2, BL_AVX2 or BL_AVX512) up to
+ * max that the CPU has. It changes nothing: lDigitAdd and lDigitSub use the level up to BL_SIMD,
+ * chosen once (see lDigitLevelGet).
+ */
+int lDigitSimd(int max) {
+  int f = lCpu();
+  int l = BL_SCALAR;
+
+  if (max >= BL_AVX512 && (f & BL_CPU_AVX512BW) != 0)
+    l = BL_AVX512;
+  else if (max >= BL_AVX2 && (f & BL_CPU_AVX2) != 0)
+    l = BL_AVX2;
+  else if (max >= BL_SSE2 && (f & BL_CPU_SSE2) != 0)
+    l = BL_SSE2;
+
+  return l;
+}
+
+/*
+ * lDigitFirst.
+ *
+ * Chooses the digit kernels (run once, by lDigitLevelGet).
+ */
+static BL_ONCE_FN(lDigitFirst) {
+  lDigitLevel = lDigitSimd(BL_SIMD);
+  BL_ONCE_END;
+}
+
+/*
+ * lDigitLevelGet.
+ *
+ * Level of the digit kernels. It's chosen on the first call from any thread, and the other ones
+ * wait for it, so there's no race on lDigitLevel.
+ */
+static int lDigitLevelGet() {
+  BL_ONCE(lDigitOnce, lDigitFirst);
+
+  return lDigitLevel;
+}
+
+/*
+ * lDigitAdd.
+ *
+ * Performs r += b over n decimal digits (values 0..9) and returns the carry out, with the
+ * kernel chosen by lDigitSimd.
+ */
+int lDigitAdd(signed char* r, const signed char* b, int n) {
+#if BL_X86 == 1
+  int l = lDigitLevelGet();
+
+  if (l == BL_AVX512)
+    return lDigitAvx512(r, b, n, 0, 0);
+
+  if (l == BL_AVX2)
+    return lDigitAvx2(r, b, n, 0, 0);
+
+  if (l == BL_SSE2)
+    return lDigitSse2(r, b, n, 0, 0);
+#endif
+
+  return lDigitTail(r, b, n, 0, 0);
+}
+
+/*
+ * lDigitSub.
+ *
+ * Performs r -= b over n decimal digits and returns the borrow out (as lDigitAdd).
+ */
+int lDigitSub(signed char* r, const signed char* b, int n) {
+#if BL_X86 == 1
+  int l = lDigitLevelGet();
+
+  if (l == BL_AVX512)
+    return lDigitAvx512(r, b, n, 1, 0);
+
+  if (l == BL_AVX2)
+    return lDigitAvx2(r, b, n, 1, 0);
+
+  if (l == BL_SSE2)
+    return lDigitSse2(r, b, n, 1, 0);
+#endif
+
+  return lDigitTail(r, b, n, 1, 0);
+}
+
+/*
+ * BLfix.
+ *
+ * Adjusts count after an operation and clears the sign of 0.
+ */
+static void BLfix(void* va, int n) {
+  n = lLen(((BigLimb*)va)->n, n);
+
+  if (n == 0) {
+    ((BigLimb*)va)->count = 0;
+    ((BigLimb*)va)->sig = 0;
+  } else
+    ((BigLimb*)va)->count = n - 1;
+}
+
+/*
+ * BLaddSig.
+ *
+ * Performs a += (sig) b, being sig the sign to apply to b. Returns 1 if the limit is reached.
+ */
+static int BLaddSig(void* va, void* vb, char sig) {
+  int na = ((BigLimb*)va)->count + 1;
+  int nb = ((BigLimb*)vb)->count + 1;
+  BLlimb* a = ((BigLimb*)va)->n;
+  BLlimb* b = ((BigLimb*)vb)->n;
+  BLlimb c;
+
+  if (((BigLimb*)va)->sig == sig) {
+    //same sign: add magnitudes
+    if (na >= nb)
+      c = lAddN(a, a, na, b, nb);
+    else
+      c = lAddN(a, b, nb, a, na);
+
+    if (nb > na)
+      na = nb;
+
+    if (c > 0) {
+      if (na >= L_MAX_LENGTH)
+        return 1;
+
+      a[na++] = c;
+    }
+
+    BLfix(va, na);
+  } else {
+    //different sign: subtract the smaller magnitude from the bigger one
+    if (lCmp(a, na, b, nb) != 2)
+      lSubN(a, a, na, b, nb);
+    else {
+      lSubN(a, b, nb, a, na);
+
+      na = nb;
+      ((BigLimb*)va)->sig = sig;
+    }
+
+    BLfix(va, na);
+  }
+
+  return 0;
+}
+
+/*
+ * BLadd. Performs a += b. Returns 1 if the limit is reached.
+ */
+int BLadd(void* va, void* vb) {
+  return BLaddSig(va, vb, ((BigLimb*)vb)->sig);
+}
+
+/*
+ * BLsub. Performs a -= b. Returns 1 if the limit is reached.
+ */
+int BLsub(void* va, void* vb) {
+  if (va == vb) {
+    //sub(a, a); result = 0
+    ((BigLimb*)va)->n[0] = 0;
+    BLfix(va, 1);
+
+    return 0;
+  }
+
+  return BLaddSig(va, vb, ((BigLimb*)vb)->sig == 0 ? -1 : 0);
+}
+
+/*
+ * BLmul. Performs a *= b. "scr" shall have BLgetScratchSize() bytes. Returns 1 if the limit is reached.
+ */
+int BLmul(void* va, void* vb, void* scr) {
+  int na = ((BigLimb*)va)->count + 1;
+  int nb = ((BigLimb*)vb)->count + 1;
+  BLlimb* r = (BLlimb*)scr;
+
+  lMul(r, ((BigLimb*)va)->n, na, ((BigLimb*)vb)->n, nb, r + 2 * L_MAX_LENGTH);
+
+  na = lLen(r, na + nb);
+
+  if (na > L_MAX_LENGTH)
+    return 1;
+
+  if (na == 0)
+    r[na++] = 0;
+
+  memcpy(((BigLimb*)va)->n, r, sizeof(BLlimb) * na);
+
+  ((BigLimb*)va)->sig = ((BigLimb*)va)->sig == ((BigLimb*)vb)->sig ? 0 : -1;
+
+  BLfix(va, na);
+
+  return 0;
+}
+
+/*
+ * BLequals.
+ *
+ * Compares two numbers.
+ *   Return 0 if a = b
+ *   Return 1 if a > b
+ *   Return 2 if a < b
+ */
+void BLequals(void* va, void* vb, int* ret) {
+  if (((BigLimb*)va)->sig != ((BigLimb*)vb)->sig) {
+    *ret = ((BigLimb*)va)->sig == 0 ? 1 : 2;
+    return;
+  }
+
+  *ret = lCmp(((BigLimb*)va)->n, ((BigLimb*)va)->count + 1, ((BigLimb*)vb)->n, ((BigLimb*)vb)->count + 1);
+
+  //both negative. Switch return
+  if (((BigLimb*)va)->sig == -1 && *ret > 0)
+    *ret = 3 - *ret;
+}
+
+/*
+ * BLgetScratchSize. Returns the size of the working buffer used by BLmul
+ */
+size_t BLgetScratchSize() {
+  return sizeof(BLlimb) * (2 * L_MAX_LENGTH + lScratch(L_MAX_LENGTH));
+}
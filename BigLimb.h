@@ -0,0 +1,256 @@
+/*
+ * BigLimb.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ */
+#ifndef BIGLIMB_H_
+#define BIGLIMB_H_
+
+//BL_BASE: limb radix. Every limb holds BL_DIGITS decimal digits.
+#define BL_BASE 1000000000u
+#define BL_DIGITS 9
+
+//L_MAX_LENGTH: limbs needed to hold a MAX_LENGTH digits number
+#ifdef C_MAX_LENGTH
+#define L_MAX_LENGTH (C_MAX_LENGTH / BL_DIGITS + 2)
+#else
+#define L_MAX_LENGTH (4096 / BL_DIGITS + 2)
+#endif
+
+//BL_SIMD: widest level of the digit kernels chosen on init (see lDigitSimd)
+#define BL_SCALAR 0
+#define BL_SSE2 1
+#define BL_AVX2 2
+#define BL_AVX512 3
+
+#ifdef C_BL_SIMD
+#define BL_SIMD C_BL_SIMD
+#else
+#define BL_SIMD BL_AVX512
+#endif
+
+//BL_ACC_LIMBS: lanes of an accumulator (the product of two L_MAX_LENGTH numbers and its carries)
+#define BL_ACC_LIMBS (2 * L_MAX_LENGTH + 2)
+
+//BL_ACC_DIGITS: digit lanes of an accumulator (a MAX_LENGTH digits number, on whole limbs)
+#define BL_ACC_DIGITS (L_MAX_LENGTH * BL_DIGITS)
+
+//BL_ACC_MAX: limbs that can be added to a lane before it has to be normalized (2^63 / BL_BASE)
+#define BL_ACC_MAX 9000000000LL
+
+//BL_ACC_DMAX: digits that can be added to a digit lane before it has to be folded (2^31 / 9)
+#define BL_ACC_DMAX 238000000
+
+//vector extensions given by lCpu
+#define BL_CPU_SSE2 1
+#define BL_CPU_AVX2 2
+#define BL_CPU_AVX512F 4
+#define BL_CPU_AVX512BW 8
+
+/*****************************************************************************
+ *                                 Structures                                *
+ *****************************************************************************/
+//limb and double limb
+typedef unsigned int BLlimb;
+typedef unsigned long long BLdlimb;
+
+//Main struct. "n" holds the magnitude (least significant limb first) and "sig" the sign (0 or -1)
+typedef struct BigLimb {
+  char k;
+  int count;
+  BLlimb n[L_MAX_LENGTH];
+  char sig;
+} BigLimb;
+
+//Montgomery context. "n" holds the modulus (k limbs), "one" and "r2" are R and R^2 mod n (R = BL_BASE^k)
+//and "ni" is -n^-1 mod BL_BASE. If "redc" is 0 (n is not coprime with 10) products are reduced by division
+typedef struct BLmont {
+  int k;
+  int redc;
+  BLlimb ni;
+  BLlimb n[L_MAX_LENGTH];
+  BLlimb one[L_MAX_LENGTH];
+  BLlimb r2[L_MAX_LENGTH];
+} BLmont;
+
+//Barrett context. "n" holds the modulus (k limbs) and "mu" is floor(BL_BASE^2k / n)
+typedef struct BLbarrett {
+  int k;
+  BLlimb n[L_MAX_LENGTH];
+  BLlimb mu[L_MAX_LENGTH + 2];
+} BLbarrett;
+
+//Divisor context. "v" holds the divisor (k limbs) multiplied by "d", so its upper limb is, at least,
+//BL_BASE / 2, and "mu" is floor(BL_BASE^2k / v) (only for divisors that are divided by Newton)
+typedef struct BLdiv {
+  int k;
+  BLlimb d;
+  BLlimb v[L_MAX_LENGTH];
+  BLlimb mu[L_MAX_LENGTH + 1];
+} BLdiv;
+
+//Accumulator. Every lane of "n" is a signed sum of limbs, and every lane of "d" a signed sum of
+//decimal digits, none of them normalized, so many numbers and products can be added with no carry
+//at all. "k" and "kd" are the lanes in use (lanes above them are 0), and "pend" and "dpend" the
+//limbs and digits added to a lane since the last normalization (see lAccNorm)
+typedef struct BLacc {
+  int k;
+  int kd;
+  long long pend;
+  int dpend;
+  long long n[BL_ACC_LIMBS];
+  int d[BL_ACC_DIGITS];
+} BLacc;
+
+/*****************************************************************************
+ *                            Function definition                            *
+ *****************************************************************************/
+//lAdc
+BLlimb lAdc(BLlimb* r, BLlimb* a, BLlimb* b, int n, BLlimb c);
+
+//lSbb
+BLlimb lSbb(BLlimb* r, BLlimb* a, BLlimb* b, int n, BLlimb c);
+
+//lAdd1
+BLlimb lAdd1(BLlimb* r, BLlimb* a, int n, BLlimb c);
+
+//lSub1
+BLlimb lSub1(BLlimb* r, BLlimb* a, int n, BLlimb c);
+
+//lMac
+BLlimb lMac(BLlimb* r, BLlimb* a, int n, BLlimb k);
+
+//lMsb
+BLlimb lMsb(BLlimb* r, BLlimb* a, int n, BLlimb k);
+
+//lDiv1
+BLlimb lDiv1(BLlimb* r, BLlimb* a, int n, BLlimb d);
+
+//lCmp
+int lCmp(BLlimb* a, int na, BLlimb* b, int nb);
+
+//lLen
+int lLen(BLlimb* a, int n);
+
+//lMul
+void lMul(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr);
+
+//lSqr
+void lSqr(BLlimb* r, BLlimb* a, int n, BLlimb* scr);
+
+//lScratch
+int lScratch(int n);
+
+//lMulThreads
+void lMulThreads(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr, int threads);
+
+//lDivRem
+void lDivRem(BLlimb* q, BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr);
+
+//lDivScratch
+int lDivScratch(int na, int nb);
+
+//lDivInit
+void lDivInit(BLdiv* c, BLlimb* b, int nb, BLlimb* scr);
+
+//lDivPre
+void lDivPre(BLlimb* q, BLlimb* r, BLlimb* a, int na, BLdiv* c, BLlimb* scr);
+
+//lMontInit
+void lMontInit(BLmont* c, BLlimb* n, int k, BLlimb* scr);
+
+//lMontMul
+void lMontMul(BLlimb* r, BLlimb* a, BLlimb* b, BLmont* c, BLlimb* scr);
+
+//lMontTo
+void lMontTo(BLlimb* r, BLlimb* a, int na, BLmont* c, BLlimb* scr);
+
+//lMontFrom
+void lMontFrom(BLlimb* r, BLlimb* a, BLmont* c, BLlimb* scr);
+
+//lMontPow
+void lMontPow(BLlimb* r, BLlimb* a, BLlimb* e, int ne, BLmont* c, BLlimb* scr);
+
+//lMontScratch
+int lMontScratch(int k, int na);
+
+//lBarrettInit
+void lBarrettInit(BLbarrett* c, BLlimb* n, int k, BLlimb* scr);
+
+//lBarrett
+void lBarrett(BLlimb* r, BLlimb* x, int nx, BLbarrett* c, BLlimb* scr);
+
+//lBarrettScratch
+int lBarrettScratch(int k, int nx);
+
+//lRoot
+int lRoot(BLlimb* r, BLlimb* a, int na, int n, BLlimb* scr);
+
+//lRootScratch
+int lRootScratch(int na);
+
+//lGcd
+int lGcd(BLlimb* g, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr);
+
+//lXgcd
+int lXgcd(BLlimb* g, BLlimb* x, int* nx, char* sx, BLlimb* y, int* ny, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr);
+
+//lModInv
+int lModInv(BLlimb* r, BLlimb* a, int na, BLlimb* n, int nn, BLlimb* scr);
+
+//lGcdScratch
+int lGcdScratch(int n);
+
+//lIsPrime
+int lIsPrime(BLlimb* a, int na, int rounds, BLlimb* scr);
+
+//lPrimeSieve
+int lPrimeSieve(char* res, BLlimb* a, int na, int len, int rounds, BLlimb* scr);
+
+//lPrimeScratch
+int lPrimeScratch(int n);
+
+//lAccInit
+void lAccInit(BLacc* c);
+
+//lAccAdd
+int lAccAdd(BLacc* c, BLlimb* a, int na, int sig);
+
+//lAccDigits
+int lAccDigits(BLacc* c, const signed char* a, int n, int sig);
+
+//lAccMul
+int lAccMul(BLacc* c, BLlimb* a, int na, BLlimb* b, int nb, int sig, BLlimb* t, BLlimb* scr);
+
+//lAccNorm
+int lAccNorm(BLacc* c);
+
+//lAccGet
+int lAccGet(BLlimb* r, char* sig, BLacc* c);
+
+//lCpu
+int lCpu();
+
+//lDigitSimd
+int lDigitSimd(int max);
+
+//lDigitAdd
+int lDigitAdd(signed char* r, const signed char* b, int n);
+
+//lDigitSub
+int lDigitSub(signed char* r, const signed char* b, int n);
+
+//lDigitAddScalar
+int lDigitAddScalar(signed char* r, const signed char* b, int n);
+
+//lDigitSubScalar
+int lDigitSubScalar(signed char* r, const signed char* b, int n);
+
+//BigLimb functions
+int BLadd(void* va, void* vb);
+int BLsub(void* va, void* vb);
+int BLmul(void* va, void* vb, void* scr);
+void BLequals(void* va, void* vb, int* ret);
+size_t BLgetScratchSize();
+#endif /* BIGLIMB_H_ */
@@ -0,0 +1,387 @@
+/*
+ * BigStream.c
+ *
+ *  Created on: 17 oct. 2026
+ *    Author: DoHITB under MIT License
+ *
+ *  Streaming input/output of BigIntegers. The reader maps a whole file (or takes a buffer of the
+ *  caller) and parses every number straight from it (as newBIN would), so there's no fgets nor
+ *  any '\0' terminated copy. The writer formats every number with toStringN on a buffer given by the
+ *  caller and only calls write when it gets full.
+ *
+ *  Numbers are separated by any whitespace (one per line, as a rule). Wrong numbers raise the
+ *  errors of newBIN (1 if they're too long, 2 on wrong characters).
+ *
+ *  Both of them count the numbers moved, so BSreadRate and BSwriteRate give numbers per second
+ *  (wall time since the reader was opened or the writer started).
+ *
+ *  CHANGELOG
+ *  v1.0
+ *    - Reader over mapped files or buffers (BSopen, BSopenMem, BSnext, BSclose).
+ *    - Writer over a buffer of the caller (BSwriterInit, BSwrite, BSflush).
+ *    - Throughput on numbers per second (BSreadRate, BSwriteRate).
+ *  v1.1
+ *    - BSnext checks every character once and stores the digits itself (8 per step), so a number
+ *      is no longer scanned again by newBIN. Files are mapped with MAP_POPULATE where there is.
+ */
+#include "stdlib.h"
+#include "string.h"
+#include "limits.h"
+#include "BigInteger.h"
+#if BI_STANDALONE != 1
+#include "BOperation.h"
+#endif
+#include "BigStream.h"
+
+//files, mappings and clock
+#if defined(_WIN32)
+#include "windows.h"
+#include "io.h"
+#define BS_WRITE(fd, b, n) _write(fd, b, (unsigned int)(n))
+#else
+#include "unistd.h"
+#include "fcntl.h"
+#include "time.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#define BS_WRITE(fd, b, n) write(fd, b, (size_t)(n))
+#endif
+
+//BS_SPACE: separators between numbers
+#define BS_SPACE(c) ((c) == ' ' || (c) == '\n' || (c) == '\r' || (c) == '\t')
+
+//BS_BSWAP64: reverses the 8 bytes of a word (little endian targets; the others take digits one by one)
+#if defined(_MSC_VER)
+#define BS_BSWAP64(x) _byteswap_uint64(x)
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BS_BSWAP64(x) __builtin_bswap64(x)
+#endif
+
+//BSnow
+static double BSnow();
+
+//BSdigits
+static void BSdigits(void* dst, const char* s, int len, int neg);
+
+/*
+ * BSnow.
+ *
+ * Returns the wall time, in seconds.
+ */
+static double BSnow() {
+#if defined(_WIN32)
+  return (double)GetTickCount64() / 1000.0;
+#else
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+#endif
+}
+
+/*
+ * BSdigits.
+ *
+ * Stores on dst the len digits of s (already checked, so there's nothing to validate), and the
+ * sign if neg is 1. It's the same number newBIN would make.
+ */
+static void BSdigits(void* dst, const char* s, int len, int neg) {
+  signed char* n = ((BigInteger*)dst)->n;
+  int j = 0;
+#ifdef BS_BSWAP64
+  unsigned long long x;
+#endif
+
+  BImemcpy(dst, 0);
+
+#ifdef BS_BSWAP64
+  //8 digits per step: the last 8 characters, reversed, are the next 8 digits (every byte is at
+  //least '0', so the subtraction doesn't borrow between them)
+  for (; j + 8 <= len; j += 8) {
+    memcpy(&x, s + len - j - 8, 8);
+    x = BS_BSWAP64(x) - 0x3030303030303030ULL;
+    memcpy(n + j, &x, 8);
+  }
+#endif
+
+  for (; j < len; j++)
+    n[j] = (signed char)(s[len - 1 - j] - '0');
+
+  ((BigInteger*)dst)->count = len - 1;
+
+  if (neg == 1)
+    n[len - 1] *= -1;
+}
+
+/*
+ * BSopenMem.
+ *
+ * Starts a reader over the "size" bytes of buf, that doesn't need to end with '\0'.
+ * buf shall live until the reader is closed.
+ */
+void BSopenMem(BSreader* r, const char* buf, size_t size) {
+  memset(r, 0, sizeof(BSreader));
+
+#if !defined(_WIN32)
+  r->fd = -1;
+#endif
+
+  r->p = buf;
+  r->size = size;
+  r->start = BSnow();
+}
+
+/*
+ * BSopen.
+ *
+ * Starts a reader over the file on "path", mapped on memory (read only). Returns 0 if everything
+ * went OK and 1 if the file can't be opened or mapped.
+ */
+int BSopen(BSreader* r, const char* path) {
+#if defined(_WIN32)
+  LARGE_INTEGER s;
+
+  BSopenMem(r, NULL, 0);
+
+  r->hf = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+  if (r->hf == INVALID_HANDLE_VALUE) {
+    r->hf = NULL;
+    return 1;
+  }
+
+  if (GetFileSizeEx(r->hf, &s) == 0) {
+    BSclose(r);
+    return 1;
+  }
+
+  r->size = (size_t)s.QuadPart;
+
+  //an empty file can't be mapped (and there's nothing to read)
+  if (r->size == 0)
+    return 0;
+
+  r->hm = CreateFileMappingA(r->hf, NULL, PAGE_READONLY, 0, 0, NULL);
+
+  if (r->hm != NULL)
+    r->map = MapViewOfFile(r->hm, FILE_MAP_READ, 0, 0, 0);
+
+  if (r->map == NULL) {
+    BSclose(r);
+    return 1;
+  }
+#else
+  struct stat s;
+
+  BSopenMem(r, NULL, 0);
+
+  r->fd = open(path, O_RDONLY);
+
+  if (r->fd < 0)
+    return 1;
+
+  if (fstat(r->fd, &s) != 0) {
+    BSclose(r);
+    return 1;
+  }
+
+  r->size = (size_t)s.st_size;
+
+  //an empty file can't be mapped (and there's nothing to read)
+  if (r->size == 0)
+    return 0;
+
+  //the pages are loaded here, not on a fault per page while parsing
+#ifdef MAP_POPULATE
+  r->map = mmap(NULL, r->size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, r->fd, 0);
+#else
+  r->map = mmap(NULL, r->size, PROT_READ, MAP_PRIVATE, r->fd, 0);
+#endif
+
+  if (r->map == MAP_FAILED) {
+    r->map = NULL;
+    BSclose(r);
+    return 1;
+  }
+
+  //the file is read once, from start to end
+  madvise(r->map, r->size, MADV_SEQUENTIAL);
+#endif
+
+  r->p = (const char*)r->map;
+  r->start = BSnow();
+
+  return 0;
+}
+
+/*
+ * BSnext.
+ *
+ * Reads the next number of the reader on dst. Returns 1 if a number was read and 0 at the end
+ * of the data. Every character is checked once: a right number goes straight to dst, and only
+ * the wrong ones (or the ones too long) are given to newBIN, that raises the error.
+ */
+int BSnext(BSreader* r, void* dst) {
+  size_t i = r->pos;
+  size_t d;
+  size_t f;
+
+  while (i < r->size && BS_SPACE(r->p[i]))
+    ++i;
+
+  if (i == r->size) {
+    r->pos = i;
+    return 0;
+  }
+
+  //digits (and a leading sign) first
+  d = r->p[i] == '-' ? i + 1 : i;
+  f = d;
+
+  while (f < r->size && (unsigned char)(r->p[f] - '0') <= 9)
+    ++f;
+
+  if ((f == r->size || BS_SPACE(r->p[f])) && f > d && f - d <= (size_t)MAX_LENGTH) {
+    r->pos = f;
+    BSdigits(dst, r->p + d, (int)(f - d), d > i);
+    ++r->count;
+
+    return 1;
+  }
+
+  //anything else is taken until the next separator, so newBIN can tell what's wrong
+  while (f < r->size && !BS_SPACE(r->p[f]))
+    ++f;
+
+  r->pos = f;
+
+  //newBIN raises error 1 for anything above MAX_LENGTH, so the length can be capped
+  newBIN(dst, r->p + i, f - i > (size_t)INT_MAX ? INT_MAX : (int)(f - i), 0);
+  ++r->count;
+
+  return 1;
+}
+
+/*
+ * BSclose.
+ *
+ * Releases the mapping and the file of a reader (a reader over a buffer has nothing to release).
+ */
+void BSclose(BSreader* r) {
+#if defined(_WIN32)
+  if (r->map != NULL)
+    UnmapViewOfFile(r->map);
+
+  if (r->hm != NULL)
+    CloseHandle(r->hm);
+
+  if (r->hf != NULL)
+    CloseHandle(r->hf);
+
+  r->hf = NULL;
+  r->hm = NULL;
+#else
+  if (r->map != NULL)
+    munmap(r->map, r->size);
+
+  if (r->fd >= 0)
+    close(r->fd);
+
+  r->fd = -1;
+#endif
+
+  r->map = NULL;
+  r->p = NULL;
+  r->size = 0;
+  r->pos = 0;
+}
+
+/*
+ * BSreadRate.
+ *
+ * Returns the numbers read per second since the reader was opened.
+ */
+double BSreadRate(BSreader* r) {
+  double t = BSnow() - r->start;
+
+  return t > 0 ? (double)r->count / t : 0;
+}
+
+/*
+ * BSwriterInit.
+ *
+ * Starts a writer to the file descriptor fd, over buf (cap bytes). Every number takes
+ * getStrLen() + 1 bytes of buf, so cap shall hold the biggest one (MAX_LENGTH + 2 is enough
+ * for any BigInteger, MAX_LENGTH + 3 for BigDouble).
+ */
+void BSwriterInit(BSwriter* w, int fd, char* buf, int cap) {
+  w->fd = fd;
+  w->buf = buf;
+  w->cap = cap;
+  w->len = 0;
+  w->count = 0;
+  w->start = BSnow();
+}
+
+/*
+ * BSflush.
+ *
+ * Writes the bytes waiting on the buffer. Returns 0 if everything went OK and 1 on a write error
+ * (the bytes not written are kept).
+ */
+int BSflush(BSwriter* w) {
+  int i = 0;
+  long long n;
+
+  while (i < w->len) {
+    n = (long long)BS_WRITE(w->fd, w->buf + i, w->len - i);
+
+    if (n <= 0)
+      break;
+
+    i += (int)n;
+  }
+
+  //keep what's left at the start of the buffer
+  memmove(w->buf, w->buf + i, (size_t)(w->len - i));
+  w->len -= i;
+
+  return w->len == 0 ? 0 : 1;
+}
+
+/*
+ * BSwrite.
+ *
+ * Formats a on the buffer of the writer, followed by '\n', writing the buffer first if there's
+ * no room left. Returns 0 if everything went OK and 1 on a write error or if the number doesn't
+ * fit on an empty buffer.
+ */
+int BSwrite(BSwriter* w, void* va) {
+  int n = toStringN(va, w->buf + w->len, w->cap - w->len);
+
+  if (n >= w->cap - w->len) {
+    if (BSflush(w) == 1 || n >= w->cap)
+      return 1;
+
+    toStringN(va, w->buf, w->cap);
+  }
+
+  //toStringN leaves '\0' after the digits, where the separator goes
+  w->buf[w->len + n] = '\n';
+  w->len += n + 1;
+  ++w->count;
+
+  return 0;
+}
+
+/*
+ * BSwriteRate.
+ *
+ * Returns the numbers written per second since the writer was started.
+ */
+double BSwriteRate(BSwriter* w) {
+  double t = BSnow() - w->start;
+
+  return t > 0 ? (double)w->count / t : 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * BigStream.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ */
+#ifndef BIGSTREAM_H_
+#define BIGSTREAM_H_
+
+#include "stddef.h"
+
+/*****************************************************************************
+ *                                 Structures                                *
+ *****************************************************************************/
+//Reader. "p" holds the "size" bytes to parse (a mapped file or a buffer of the caller) and "pos"
+//the next byte. "count" and "start" measure the throughput
+typedef struct BSreader {
+  const char* p;
+  size_t size;
+  size_t pos;
+  long long count;
+  double start;
+  void* map;
+#if defined(_WIN32)
+  void* hf;
+  void* hm;
+#else
+  int fd;
+#endif
+} BSreader;
+
+//Writer. Numbers are formatted on "buf" (cap bytes, given by the caller) and written to "fd" when
+//it gets full. "len" holds the bytes waiting on buf
+typedef struct BSwriter {
+  int fd;
+  char* buf;
+  int cap;
+  int len;
+  long long count;
+  double start;
+} BSwriter;
+
+/*****************************************************************************
+ *                            Function definition                            *
+ *****************************************************************************/
+//BSopen
+int BSopen(BSreader* r, const char* path);
+
+//BSopenMem
+void BSopenMem(BSreader* r, const char* buf, size_t size);
+
+//BSnext
+int BSnext(BSreader* r, void* dst);
+
+//BSclose
+void BSclose(BSreader* r);
+
+//BSreadRate
+double BSreadRate(BSreader* r);
+
+//BSwriterInit
+void BSwriterInit(BSwriter* w, int fd, char* buf, int cap);
+
+//BSwrite
+int BSwrite(BSwriter* w, void* va);
+
+//BSflush
+int BSflush(BSwriter* w);
+
+//BSwriteRate
+double BSwriteRate(BSwriter* w);
+
+#endif /* BIGSTREAM_H_ */
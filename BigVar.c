@@ -0,0 +1,934 @@
+/*
+ * BigVar.c
+ *
+ *  Created on: 17 oct. 2026
+ *    Author: DoHITB under MIT License
+ *
+ *  Variable length numbers. A BigVar keeps its magnitude on base 10^9 limbs (as BigLimb does),
+ *  but it only holds the limbs it needs: up to BV_SMALL limbs are stored inside the structure
+ *  and bigger values go to the heap. Capacity ("cap") is kept apart from length ("count"), so
+ *  copies only move count + 1 limbs, and values are not bounded by MAX_LENGTH.
+ *
+ *  A BigVar shall be started with BVinit and released with BVfree. Copying the structure itself
+ *  (memcpy) shares the heap limbs; use BVcopy to get an independent copy.
+ *
+ *  Functions returning int give 0 if everything went OK, 1 if memory can't be allocated (or
+ *  the limit of the destination is reached) and 2 on wrong input data.
+ *
+ *  CHANGELOG
+ *  v1.0
+ *    - BigVar structure with small buffer storage (BVinit, BVfree, BVreserve, BVshrink, BVcopy).
+ *    - Conversion from/to strings (newBV, BVtoString) and BigInteger (BI2BV, BV2BI).
+ *    - Basic operations (BVadd, BVsub, BVmul, BVequals).
+ *  v1.1
+ *    - Remainder (BVmod).
+ *    - Product and remainder trees (BVprodTree, BVremTree, BVfreeTree), built level by level
+ *      between threads. Remainders of the leaves are given one by one through a callback.
+ */
+#include "stdlib.h"
+#include "string.h"
+#include "BigInteger.h"
+#include "BigVar.h"
+
+//threads for the trees
+#if defined(_WIN32)
+#include "windows.h"
+#define BV_THREAD_FN DWORD WINAPI
+#define BV_THREAD_START(t, f, a) (((t) = CreateThread(NULL, 0, f, a, 0, NULL)) == NULL)
+#define BV_THREAD_JOIN(t) (WaitForSingleObject(t, INFINITE), CloseHandle(t))
+typedef HANDLE BVthread;
+typedef DWORD (WINAPI *BVjobFn)(void*);
+#else
+#include "pthread.h"
+#define BV_THREAD_FN void*
+#define BV_THREAD_START(t, f, a) pthread_create(&(t), NULL, f, a)
+#define BV_THREAD_JOIN(t) pthread_join(t, NULL)
+typedef pthread_t BVthread;
+typedef void* (*BVjobFn)(void*);
+#endif
+
+//BV_TREE_BLOCK: leaf remainders made (per thread) before handing them to the callback
+#define BV_TREE_BLOCK 64
+
+//work of a tree thread: nodes [lo, hi) of dst from src (and mod on remainder trees)
+typedef struct BVjob {
+  BVthread th;
+  BigVar* dst;
+  BigVar* src;
+  BigVar* mod;
+  int n;
+  int lo;
+  int hi;
+  int off;
+  int sq;
+  int threads;
+  int ret;
+} BVjob;
+
+/*
+ * BVinit.
+ *
+ * Starts a BigVar with 0 as value, using the inner storage.
+ */
+void BVinit(void* va) {
+  ((BigVar*)va)->k = 'v';
+  ((BigVar*)va)->sig = 0;
+  ((BigVar*)va)->count = 0;
+  ((BigVar*)va)->cap = BV_SMALL;
+
+  memset(((BigVar*)va)->d.s, 0, sizeof(BLlimb) * BV_SMALL);
+}
+
+/*
+ * BVfree.
+ *
+ * Releases the heap limbs (if any). The BigVar is left as 0 and can be used again.
+ */
+void BVfree(void* va) {
+  if (((BigVar*)va)->cap > BV_SMALL)
+    free(((BigVar*)va)->d.h);
+
+  BVinit(va);
+}
+
+/*
+ * BVreserve.
+ *
+ * Makes room for, at least, n limbs. Capacity grows twice as needed, so a growing value
+ * doesn't reallocate on every operation.
+ */
+int BVreserve(void* va, int n) {
+  int cap = ((BigVar*)va)->cap;
+  BLlimb* p;
+
+  if (n <= cap)
+    return 0;
+
+  if (cap * 2 > n)
+    n = cap * 2;
+
+  if (cap > BV_SMALL)
+    p = (BLlimb*)realloc(((BigVar*)va)->d.h, sizeof(BLlimb) * n);
+  else {
+    p = (BLlimb*)malloc(sizeof(BLlimb) * n);
+
+    if (p != NULL)
+      memcpy(p, ((BigVar*)va)->d.s, sizeof(BLlimb) * BV_SMALL);
+  }
+
+  if (p == NULL)
+    return 1;
+
+  ((BigVar*)va)->d.h = p;
+  ((BigVar*)va)->cap = n;
+
+  return 0;
+}
+
+/*
+ * BVshrink.
+ *
+ * Adjusts the capacity to the limbs in use, going back to the inner storage if they fit.
+ */
+int BVshrink(void* va) {
+  int n = ((BigVar*)va)->count + 1;
+  BLlimb* p;
+
+  if (((BigVar*)va)->cap <= BV_SMALL || ((BigVar*)va)->cap == n)
+    return 0;
+
+  if (n <= BV_SMALL) {
+    p = ((BigVar*)va)->d.h;
+
+    memcpy(((BigVar*)va)->d.s, p, sizeof(BLlimb) * n);
+    memset(((BigVar*)va)->d.s + n, 0, sizeof(BLlimb) * (BV_SMALL - n));
+    free(p);
+
+    ((BigVar*)va)->cap = BV_SMALL;
+
+    return 0;
+  }
+
+  p = (BLlimb*)realloc(((BigVar*)va)->d.h, sizeof(BLlimb) * n);
+
+  if (p == NULL)
+    return 1;
+
+  ((BigVar*)va)->d.h = p;
+  ((BigVar*)va)->cap = n;
+
+  return 0;
+}
+
+/*
+ * BVfix.
+ *
+ * Adjusts count after an operation and clears the sign of 0.
+ */
+static void BVfix(void* va, int n) {
+  n = lLen(BV_DATA(va), n);
+
+  if (n == 0) {
+    BV_DATA(va)[0] = 0;
+    ((BigVar*)va)->count = 0;
+    ((BigVar*)va)->sig = 0;
+  } else
+    ((BigVar*)va)->count = n - 1;
+}
+
+/*
+ * BVcopy.
+ *
+ * Copies src into dst (both of them started). Only the limbs in use are moved.
+ */
+int BVcopy(void* dst, void* src) {
+  int n = ((BigVar*)src)->count + 1;
+
+  if (dst == src)
+    return 0;
+
+  if (BVreserve(dst, n) == 1)
+    return 1;
+
+  memcpy(BV_DATA(dst), BV_DATA(src), sizeof(BLlimb) * n);
+
+  ((BigVar*)dst)->count = ((BigVar*)src)->count;
+  ((BigVar*)dst)->sig = ((BigVar*)src)->sig;
+
+  return 0;
+}
+
+/*
+ * newBV.
+ *
+ * Loads a decimal string (with an optional "-" sign) into a started BigVar.
+ */
+int newBV(void* dst, const char* s) {
+  int sig = 0;
+  int len;
+  int n;
+  int i;
+  int j;
+  int f;
+  BLlimb v;
+
+  if (s[0] == '-') {
+    sig = -1;
+    ++s;
+  }
+
+  len = (int)strlen(s);
+
+  if (len == 0)
+    return 2;
+
+  for (i = 0; i < len; i++)
+    if (s[i] < '0' || s[i] > '9')
+      return 2;
+
+  n = (len + BL_DIGITS - 1) / BL_DIGITS;
+
+  if (BVreserve(dst, n) == 1)
+    return 1;
+
+  //every limb takes (up to) BL_DIGITS characters from the end of the string
+  for (i = 0; i < n; i++) {
+    f = len - i * BL_DIGITS;
+    j = f - BL_DIGITS < 0 ? 0 : f - BL_DIGITS;
+
+    for (v = 0; j < f; j++)
+      v = v * 10 + (BLlimb)(s[j] - '0');
+
+    BV_DATA(dst)[i] = v;
+  }
+
+  ((BigVar*)dst)->sig = (char)sig;
+  BVfix(dst, n);
+
+  return 0;
+}
+
+/*
+ * BVstrlen.
+ *
+ * Returns the characters BVtoString writes (sign included, '\0' excluded).
+ */
+int BVstrlen(void* va) {
+  int i = 1;
+  BLlimb v = BV_DATA(va)[((BigVar*)va)->count];
+
+  for (; v >= 10; v /= 10)
+    ++i;
+
+  return i + ((BigVar*)va)->count * BL_DIGITS + (((BigVar*)va)->sig == -1 ? 1 : 0);
+}
+
+/*
+ * BVtoString.
+ *
+ * Gets the string representation of a BigVar. dst shall have BVstrlen() + 1 characters.
+ */
+void BVtoString(void* va, char* dst) {
+  BLlimb* a = BV_DATA(va);
+  int i = ((BigVar*)va)->count;
+  int j;
+  int f;
+  BLlimb v;
+
+  if (((BigVar*)va)->sig == -1)
+    *dst++ = '-';
+
+  //upper limb, without leading zeros
+  f = BVstrlen(va) - i * BL_DIGITS - (((BigVar*)va)->sig == -1 ? 1 : 0);
+
+  for (v = a[i], j = f - 1; j >= 0; j--) {
+    dst[j] = (char)('0' + v % 10);
+    v /= 10;
+  }
+
+  dst += f;
+
+  //the rest of limbs, with all their digits
+  for (--i; i >= 0; i--) {
+    for (v = a[i], j = BL_DIGITS - 1; j >= 0; j--) {
+      dst[j] = (char)('0' + v % 10);
+      v /= 10;
+    }
+
+    dst += BL_DIGITS;
+  }
+
+  *dst = '\0';
+}
+
+/*
+ * BI2BV.
+ *
+ * Converts a BigInteger into a (started) BigVar.
+ */
+int BI2BV(void* dst, void* src) {
+  int top = ((BigInteger*)src)->count;
+  int n = top / BL_DIGITS + 1;
+  int i;
+  int j;
+  int d;
+  BLlimb v;
+
+  if (BVreserve(dst, n) == 1)
+    return 1;
+
+  for (i = 0; i < n; i++) {
+    v = 0;
+
+    //most significant digit of the group goes first
+    for (j = i * BL_DIGITS + BL_DIGITS - 1; j >= i * BL_DIGITS; j--) {
+      if (j <= top) {
+        d = ((BigInteger*)src)->n[j];
+        v = v * 10 + (BLlimb)(d < 0 ? -d : d);
+      }
+    }
+
+    BV_DATA(dst)[i] = v;
+  }
+
+  ((BigVar*)dst)->sig = ((BigInteger*)src)->n[top] < 0 ? -1 : 0;
+  BVfix(dst, n);
+
+  return 0;
+}
+
+/*
+ * BV2BI.
+ *
+ * Converts a BigVar into a BigInteger. Returns 1 if it doesn't fit on MAX_LENGTH digits.
+ */
+int BV2BI(void* dst, void* src) {
+  BLlimb* a = BV_DATA(src);
+  int n = ((BigVar*)src)->count;
+  int x = 0;
+  int i;
+  BLlimb v;
+
+  //digits of the most significant limb
+  for (v = a[n]; v > 0; v /= 10)
+    ++x;
+
+  if (n * BL_DIGITS + x > MAX_LENGTH)
+    return 1;
+
+  ((BigInteger*)dst)->k = 'i';
+  memset(((BigInteger*)dst)->n, 0, MAX_LENGTH);
+
+  for (x = 0, i = 0; i < n; i++)
+    for (v = a[i]; x < (i + 1) * BL_DIGITS; x++) {
+      ((BigInteger*)dst)->n[x] = (signed char)(v % 10);
+      v /= 10;
+    }
+
+  for (v = a[n]; v > 0; v /= 10)
+    ((BigInteger*)dst)->n[x++] = (signed char)(v % 10);
+
+  ((BigInteger*)dst)->count = x > 0 ? x - 1 : 0;
+
+  if (((BigVar*)src)->sig == -1)
+    ((BigInteger*)dst)->n[((BigInteger*)dst)->count] *= -1;
+
+  return 0;
+}
+
+/*
+ * BVaddSig.
+ *
+ * Performs a += (sig) b, being sig the sign to apply to b.
+ */
+static int BVaddSig(void* va, void* vb, char sig) {
+  int na = ((BigVar*)va)->count + 1;
+  int nb = ((BigVar*)vb)->count + 1;
+  BLlimb* a;
+  BLlimb* b;
+  BLlimb c;
+
+  //room for the carry. a and b can be the same BigVar, so limbs are taken afterwards
+  if (BVreserve(va, (na > nb ? na : nb) + 1) == 1)
+    return 1;
+
+  a = BV_DATA(va);
+  b = BV_DATA(vb);
+
+  if (((BigVar*)va)->sig == sig) {
+    //same sign: add magnitudes
+    if (na >= nb)
+      c = lAdd1(a + nb, a + nb, na - nb, lAdc(a, a, b, nb, 0));
+    else
+      c = lAdd1(a + na, b + na, nb - na, lAdc(a, a, b, na, 0));
+
+    if (nb > na)
+      na = nb;
+
+    a[na++] = c;
+  } else {
+    //different sign: subtract the smaller magnitude from the bigger one
+    if (lCmp(a, na, b, nb) != 2)
+      lSub1(a + nb, a + nb, na - nb, lSbb(a, a, b, nb, 0));
+    else {
+      lSub1(a + na, b + na, nb - na, lSbb(a, b, a, na, 0));
+
+      na = nb;
+      ((BigVar*)va)->sig = sig;
+    }
+  }
+
+  BVfix(va, na);
+
+  return 0;
+}
+
+/*
+ * BVadd. Performs a += b.
+ */
+int BVadd(void* va, void* vb) {
+  return BVaddSig(va, vb, ((BigVar*)vb)->sig);
+}
+
+/*
+ * BVsub. Performs a -= b.
+ */
+int BVsub(void* va, void* vb) {
+  if (va == vb) {
+    //sub(a, a); result = 0
+    BVfix(va, 0);
+
+    return 0;
+  }
+
+  return BVaddSig(va, vb, ((BigVar*)vb)->sig == 0 ? -1 : 0);
+}
+
+/*
+ * BVmulThreads.
+ *
+ * Performs a *= b as BVmul, splitting big products between the given threads (lMulThreads).
+ */
+static int BVmulThreads(void* va, void* vb, int threads) {
+  int na = ((BigVar*)va)->count + 1;
+  int nb = ((BigVar*)vb)->count + 1;
+  int nr;
+  int s = lScratch(na > nb ? na : nb);
+  BLlimb t[2 * BV_SMALL];
+  BLlimb* r = t;
+  BLlimb* scr = NULL;
+
+  if (na + nb > 2 * BV_SMALL) {
+    r = (BLlimb*)malloc(sizeof(BLlimb) * (na + nb));
+
+    if (r == NULL)
+      return 1;
+  }
+
+  if (s > 0) {
+    scr = (BLlimb*)malloc(sizeof(BLlimb) * s);
+
+    if (scr == NULL) {
+      if (r != t)
+        free(r);
+
+      return 1;
+    }
+  }
+
+  lMulThreads(r, BV_DATA(va), na, BV_DATA(vb), nb, scr, threads);
+  nr = lLen(r, na + nb);
+
+  ((BigVar*)va)->sig = ((BigVar*)va)->sig == ((BigVar*)vb)->sig ? 0 : -1;
+
+  if (nr <= ((BigVar*)va)->cap || r == t) {
+    //stack products are always copied
+    if (BVreserve(va, nr) == 1) {
+      free(scr);
+
+      return 1;
+    }
+
+    memcpy(BV_DATA(va), r, sizeof(BLlimb) * (nr > 0 ? nr : 1));
+
+    if (r != t)
+      free(r);
+  } else {
+    //the product buffer becomes the new storage
+    if (((BigVar*)va)->cap > BV_SMALL)
+      free(((BigVar*)va)->d.h);
+
+    ((BigVar*)va)->d.h = r;
+    ((BigVar*)va)->cap = na + nb;
+  }
+
+  free(scr);
+
+  BVfix(va, nr);
+
+  return 0;
+}
+
+/*
+ * BVmul.
+ *
+ * Performs a *= b. Small products are made on the stack; bigger ones on a new heap buffer
+ * that becomes the storage of a if it doesn't fit on its current capacity.
+ */
+int BVmul(void* va, void* vb) {
+  return BVmulThreads(va, vb, 1);
+}
+
+/*
+ * BVmod.
+ *
+ * Performs a = a % b. The remainder has the sign of a (as in C). Returns 2 if b is 0.
+ */
+int BVmod(void* va, void* vb) {
+  int na = ((BigVar*)va)->count + 1;
+  int nb = ((BigVar*)vb)->count + 1;
+  BLlimb* q;
+  BLlimb* r;
+  BLlimb* scr;
+
+  if (nb == 1 && BV_DATA(vb)[0] == 0)
+    return 2;
+
+  if (va == vb) {
+    //a % a = 0
+    BVfix(va, 0);
+
+    return 0;
+  }
+
+  //|a| < |b|, a is the remainder
+  if (na < nb)
+    return 0;
+
+  q = (BLlimb*)malloc(sizeof(BLlimb) * ((na - nb + 1) + nb + lDivScratch(na, nb)));
+
+  if (q == NULL)
+    return 1;
+
+  r = q + (na - nb + 1);
+  scr = r + nb;
+
+  lDivRem(q, r, BV_DATA(va), na, BV_DATA(vb), nb, scr);
+
+  memcpy(BV_DATA(va), r, sizeof(BLlimb) * nb);
+  free(q);
+
+  BVfix(va, nb);
+
+  return 0;
+}
+
+/*
+ * BVrun.
+ *
+ * Runs w tree jobs: jobs 1 .. w - 1 on their own threads, and job 0 (and the ones whose thread
+ * can't be started) on the caller. Returns the worst return code.
+ */
+static int BVrun(BVjob* j, int w, BVjobFn f) {
+  int ret = 0;
+  int i = 1;
+
+  for (; i < w; i++)
+    if (BV_THREAD_START(j[i].th, f, j + i) != 0)
+      j[i].threads = 0;
+
+  f(j);
+
+  for (i = 1; i < w; i++) {
+    if (j[i].threads == 0) {
+      j[i].threads = 1;
+      f(j + i);
+    } else
+      BV_THREAD_JOIN(j[i].th);
+  }
+
+  for (i = 0; i < w; i++)
+    if (j[i].ret > ret)
+      ret = j[i].ret;
+
+  return ret;
+}
+
+/*
+ * BVsplit.
+ *
+ * Splits the n nodes of a level between, at most, "threads" jobs. When there are less nodes
+ * than threads, every product gets the threads left. Returns the number of jobs.
+ */
+static int BVsplit(BVjob* j, int n, int threads) {
+  int w = threads < n ? threads : n;
+  int i = 0;
+
+  for (; i < w; i++) {
+    j[i].lo = (int)((long long)n * i / w);
+    j[i].hi = (int)((long long)n * (i + 1) / w);
+    j[i].threads = threads / w;
+    j[i].ret = 0;
+  }
+
+  return w;
+}
+
+/*
+ * BVprodJob.
+ *
+ * Product tree job: dst[i] = src[2i] * src[2i + 1] (or src[2i] if it has no pair).
+ */
+static BV_THREAD_FN BVprodJob(void* vj) {
+  BVjob* j = (BVjob*)vj;
+  int i = j->lo;
+
+  for (; i < j->hi && j->ret == 0; i++) {
+    j->ret = BVcopy(j->dst + i, j->src + 2 * i);
+
+    if (j->ret == 0 && 2 * i + 1 < j->n)
+      j->ret = BVmulThreads(j->dst + i, j->src + 2 * i + 1, j->threads);
+  }
+
+  return 0;
+}
+
+/*
+ * BVremJob.
+ *
+ * Remainder tree job: dst[i] = src[(i + off) / 2] % mod[i + off] (or % mod[i + off]^2 if sq is 1).
+ */
+static BV_THREAD_FN BVremJob(void* vj) {
+  BVjob* j = (BVjob*)vj;
+  BigVar t;
+  int i = j->lo;
+
+  BVinit(&t);
+
+  for (; i < j->hi && j->ret == 0; i++) {
+    j->ret = BVcopy(j->dst + i, j->src + (i + j->off) / 2);
+
+    if (j->ret == 0 && j->sq == 1) {
+      j->ret = BVcopy(&t, j->mod + i + j->off);
+
+      if (j->ret == 0)
+        j->ret = BVmulThreads(&t, &t, j->threads);
+
+      if (j->ret == 0)
+        j->ret = BVmod(j->dst + i, &t);
+    } else if (j->ret == 0)
+      j->ret = BVmod(j->dst + i, j->mod + i + j->off);
+  }
+
+  BVfree(&t);
+
+  return 0;
+}
+
+/*
+ * BVfreeTree.
+ *
+ * Releases the nodes of a product tree (the leaves belong to the caller).
+ */
+void BVfreeTree(void* vt) {
+  BVtree* t = (BVtree*)vt;
+  int l = 1;
+  int i;
+
+  if (t->level != NULL) {
+    for (; l < t->levels; l++) {
+      if (t->level[l] == NULL)
+        continue;
+
+      for (i = 0; i < t->size[l]; i++)
+        BVfree(t->level[l] + i);
+
+      free(t->level[l]);
+    }
+  }
+
+  free(t->level);
+  free(t->size);
+
+  t->level = NULL;
+  t->size = NULL;
+  t->levels = 0;
+}
+
+/*
+ * BVprodTree.
+ *
+ * Builds the product tree of n leaves: level 0 are the leaves themselves (they are not copied,
+ * so they must live as long as the tree) and every node is the product of its two children,
+ * up to the root (level[levels - 1][0], the product of all of them).
+ * Every level is split between "threads" threads.
+ */
+int BVprodTree(void* vt, void* leaves, int n, int threads) {
+  BVtree* t = (BVtree*)vt;
+  BVjob* j;
+  int l = 1;
+  int i;
+  int w;
+  int ret = 0;
+
+  t->levels = 0;
+  t->level = NULL;
+  t->size = NULL;
+
+  if (leaves == NULL || n < 1)
+    return 2;
+
+  if (threads < 1)
+    threads = 1;
+
+  //levels: n, ceil(n / 2)... 1
+  for (i = n, t->levels = 1; i > 1; i = (i + 1) / 2)
+    ++t->levels;
+
+  t->level = (BigVar**)calloc(t->levels, sizeof(BigVar*));
+  t->size = (int*)malloc(sizeof(int) * t->levels);
+  j = (BVjob*)malloc(sizeof(BVjob) * threads);
+
+  if (t->level == NULL || t->size == NULL || j == NULL) {
+    free(j);
+    BVfreeTree(t);
+
+    return 1;
+  }
+
+  t->level[0] = (BigVar*)leaves;
+  t->size[0] = n;
+
+  for (; l < t->levels && ret == 0; l++) {
+    t->size[l] = (t->size[l - 1] + 1) / 2;
+    t->level[l] = (BigVar*)malloc(sizeof(BigVar) * t->size[l]);
+
+    if (t->level[l] == NULL) {
+      ret = 1;
+      break;
+    }
+
+    for (i = 0; i < t->size[l]; i++)
+      BVinit(t->level[l] + i);
+
+    w = BVsplit(j, t->size[l], threads);
+
+    for (i = 0; i < w; i++) {
+      j[i].dst = t->level[l];
+      j[i].src = t->level[l - 1];
+      j[i].n = t->size[l - 1];
+    }
+
+    ret = BVrun(j, w, BVprodJob);
+  }
+
+  free(j);
+
+  if (ret != 0)
+    BVfreeTree(t);
+
+  return ret;
+}
+
+/*
+ * BVremTree.
+ *
+ * Remainder tree: gets x % leaf for every leaf of the product tree, going down from x % root
+ * (every node is reduced by its children, so no division is bigger than needed).
+ * If sq is 1, remainders are taken modulo the square of every node (x % leaf^2, as batch GCD
+ * needs with x being the root).
+ *
+ * Leaf remainders are not kept: they are made by blocks (split between threads) and given in
+ * order to out(i, remainder, arg) on the calling thread. The remainder is only valid during the
+ * call. If out returns non 0, the tree stops and that value is returned.
+ */
+int BVremTree(void* vt, void* vx, int sq, int (*out)(int, void*, void*), void* arg, int threads) {
+  BVtree* t = (BVtree*)vt;
+  BVjob* j;
+  BigVar* up;
+  BigVar* cur = NULL;
+  int n = 1;
+  int l;
+  int i;
+  int w;
+  int b;
+  int ret = 0;
+
+  if (t->level == NULL || vx == NULL || out == NULL)
+    return 2;
+
+  if (threads < 1)
+    threads = 1;
+
+  j = (BVjob*)malloc(sizeof(BVjob) * threads);
+  up = (BigVar*)malloc(sizeof(BigVar));
+
+  if (j == NULL || up == NULL) {
+    free(j);
+    free(up);
+
+    return 1;
+  }
+
+  //x % root
+  BVinit(up);
+
+  ret = BVcopy(up, vx);
+
+  if (ret == 0) {
+    w = BVsplit(j, 1, threads);
+
+    j[0].dst = up;
+    j[0].src = up;
+    j[0].mod = t->level[t->levels - 1];
+    j[0].off = 0;
+    j[0].sq = sq;
+
+    ret = BVrun(j, w, BVremJob);
+  }
+
+  //inner levels, from the top: every node is reduced by itself from its parent's remainder
+  for (l = t->levels - 2; l > 0 && ret == 0; l--) {
+    cur = (BigVar*)malloc(sizeof(BigVar) * t->size[l]);
+
+    if (cur == NULL) {
+      ret = 1;
+      break;
+    }
+
+    for (i = 0; i < t->size[l]; i++)
+      BVinit(cur + i);
+
+    w = BVsplit(j, t->size[l], threads);
+
+    for (i = 0; i < w; i++) {
+      j[i].dst = cur;
+      j[i].src = up;
+      j[i].mod = t->level[l];
+      j[i].off = 0;
+      j[i].sq = sq;
+    }
+
+    ret = BVrun(j, w, BVremJob);
+
+    for (i = 0; i < n; i++)
+      BVfree(up + i);
+
+    free(up);
+
+    up = cur;
+    n = t->size[l];
+    cur = NULL;
+  }
+
+  //leaves (with a single leaf, the root remainder is the result)
+  if (ret == 0 && t->levels == 1)
+    ret = out(0, up, arg);
+  else if (ret == 0) {
+    b = BV_TREE_BLOCK * threads;
+    cur = (BigVar*)malloc(sizeof(BigVar) * b);
+
+    if (cur == NULL)
+      ret = 1;
+    else {
+      for (i = 0; i < b; i++)
+        BVinit(cur + i);
+    }
+
+    for (l = 0; l < t->size[0] && ret == 0; l += b) {
+      if (b > t->size[0] - l)
+        b = t->size[0] - l;
+
+      w = BVsplit(j, b, threads);
+
+      for (i = 0; i < w; i++) {
+        j[i].dst = cur;
+        j[i].src = up;
+        j[i].mod = t->level[0];
+        j[i].off = l;
+        j[i].sq = sq;
+      }
+
+      ret = BVrun(j, w, BVremJob);
+
+      for (i = 0; i < b && ret == 0; i++)
+        ret = out(l + i, cur + i, arg);
+    }
+
+    if (cur != NULL) {
+      for (i = 0; i < BV_TREE_BLOCK * threads; i++)
+        BVfree(cur + i);
+
+      free(cur);
+    }
+  }
+
+  for (i = 0; i < n; i++)
+    BVfree(up + i);
+
+  free(up);
+  free(j);
+
+  return ret;
+}
+
+/*
+ * BVequals.
+ *
+ * Compares two numbers.
+ *   Return 0 if a = b
+ *   Return 1 if a > b
+ *   Return 2 if a < b
+ */
+void BVequals(void* va, void* vb, int* ret) {
+  if (((BigVar*)va)->sig != ((BigVar*)vb)->sig) {
+    *ret = ((BigVar*)va)->sig == 0 ? 1 : 2;
+    return;
+  }
+
+  *ret = lCmp(BV_DATA(va), ((BigVar*)va)->count + 1, BV_DATA(vb), ((BigVar*)vb)->count + 1);
+
+  //both negative. Switch return
+  if (((BigVar*)va)->sig == -1 && *ret > 0)
+    *ret = 3 - *ret;
+}
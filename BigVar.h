@@ -0,0 +1,102 @@
+/*
+ * BigVar.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ */
+#ifndef BIGVAR_H_
+#define BIGVAR_H_
+
+#include "BigLimb.h"
+
+//BV_SMALL: limbs kept inside the structure (BV_SMALL * BL_DIGITS digits) before going to the heap
+#ifdef C_BV_SMALL
+#define BV_SMALL C_BV_SMALL
+#else
+#define BV_SMALL 4
+#endif
+
+//BV_DATA: limbs of a BigVar (inline or on the heap)
+#define BV_DATA(v) (((BigVar*)(v))->cap > BV_SMALL ? ((BigVar*)(v))->d.h : ((BigVar*)(v))->d.s)
+
+/*****************************************************************************
+ *                                 Structures                                *
+ *****************************************************************************/
+//Variable length struct. "count" is the upper limb used (as on BigLimb) and "cap" the limbs
+//available. While cap is BV_SMALL, limbs are stored on "d.s"; otherwise "d.h" points to the heap
+typedef struct BigVar {
+  char k;
+  char sig;
+  int count;
+  int cap;
+  union {
+    BLlimb s[BV_SMALL];
+    BLlimb* h;
+  } d;
+} BigVar;
+
+//Product tree. "level[0]" are the leaves (owned by the caller), "level[l]" has "size[l]" nodes,
+//each one the product of its two children on level l - 1, and level[levels - 1][0] is the root
+typedef struct BVtree {
+  int levels;
+  int* size;
+  BigVar** level;
+} BVtree;
+
+/*****************************************************************************
+ *                            Function definition                            *
+ *****************************************************************************/
+//BVinit
+void BVinit(void* va);
+
+//BVfree
+void BVfree(void* va);
+
+//BVreserve
+int BVreserve(void* va, int n);
+
+//BVshrink
+int BVshrink(void* va);
+
+//BVcopy
+int BVcopy(void* dst, void* src);
+
+//newBV
+int newBV(void* dst, const char* s);
+
+//BVtoString
+void BVtoString(void* va, char* dst);
+
+//BVstrlen
+int BVstrlen(void* va);
+
+//BI2BV
+int BI2BV(void* dst, void* src);
+
+//BV2BI
+int BV2BI(void* dst, void* src);
+
+//BVadd
+int BVadd(void* va, void* vb);
+
+//BVsub
+int BVsub(void* va, void* vb);
+
+//BVmul
+int BVmul(void* va, void* vb);
+
+//BVmod
+int BVmod(void* va, void* vb);
+
+//BVequals
+void BVequals(void* va, void* vb, int* ret);
+
+//BVprodTree
+int BVprodTree(void* vt, void* leaves, int n, int threads);
+
+//BVremTree
+int BVremTree(void* vt, void* vx, int sq, int (*out)(int, void*, void*), void* arg, int threads);
+
+//BVfreeTree
+void BVfreeTree(void* vt);
+#endif /* BIGVAR_H_ */
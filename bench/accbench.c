@@ -0,0 +1,132 @@
+/*
+ * accbench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Accumulator benchmark (standalone mode). A dot product of BENCH_COUNT pairs is made with mul and
+ *  add (every term is normalized and added on digits) and with accDot, and BENCH_COUNT numbers are
+ *  summed with add and with accAdd. Both results are checked. Times are given on terms per second.
+ *
+ *  Build: gcc -O2 -x c -DBI_STANDALONE=1 -DCVALIDATE=0 -I.. accbench.c ../BigInteger.cu ../BigLimb.c -lpthread -o accbench
+ */
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include "BigInteger.h"
+
+//terms on every dot product or sum
+#define BENCH_COUNT 1000
+
+//time budget for every measure, in seconds
+#define BENCH_TIME 0.3
+
+/*
+ * now. Wall time, in seconds.
+ */
+static double now() {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+int main() {
+  int sizes[] = { 18, 90, 400, 1500 };
+  int z = 0;
+  int i;
+  int j;
+  int n;
+  int reps;
+  int ret;
+  char s[2048];
+  void* m = malloc(getMemorySize());
+  void* c;
+  BigInteger* a = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  BigInteger* b = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  BigInteger r;
+  BigInteger x;
+  BigInteger y;
+  double str;
+
+  init(m);
+  c = malloc(getAccSize());
+  newBI(&r, "0", 0);
+  newBI(&x, "0", 0);
+  newBI(&y, "0", 0);
+
+  printf("digits\tdot mul+add\taccDot\t\tsum add\t\taccAdd\t\t(terms/s)\n");
+
+  for (; z < (int)(sizeof(sizes) / sizeof(int)); z++) {
+    n = sizes[z];
+
+    //random numbers, half of them negative
+    for (i = 0; i < BENCH_COUNT; i++) {
+      for (j = 0; j < n; j++)
+        s[j] = (char)('0' + (j == 0 ? 1 + rand() % 9 : rand() % 10));
+
+      s[n] = '\0';
+      newBI(&a[i], s, i % 2 == 0 ? 0 : -1);
+      s[n / 2 + 1] = '\0';
+      newBI(&b[i], s, 0);
+    }
+
+    printf("%d\t", n);
+
+    //dot product: mul and add
+    for (reps = 0, str = now(); now() - str < BENCH_TIME; reps++) {
+      clean(&r);
+
+      for (i = 0; i < BENCH_COUNT; i++) {
+        memcpy(&x, &a[i], sizeof(BigInteger));
+        mul(&x, &b[i], m);
+        add(&r, &x, m);
+      }
+    }
+
+    printf("%12.0f\t", (double)reps * BENCH_COUNT / (now() - str));
+
+    //dot product: accDot
+    for (reps = 0, str = now(); now() - str < BENCH_TIME; reps++) {
+      accInit(c);
+      accDot(c, a, b, BENCH_COUNT, m);
+      accGet(&y, c, m);
+    }
+
+    printf("%12.0f\t", (double)reps * BENCH_COUNT / (now() - str));
+    equals(&r, &y, &ret);
+
+    if (ret != 0)
+      printf("\n  dot products differ\n");
+
+    //sum: add
+    for (reps = 0, str = now(); now() - str < BENCH_TIME; reps++) {
+      clean(&r);
+
+      for (i = 0; i < BENCH_COUNT; i++)
+        add(&r, &a[i], m);
+    }
+
+    printf("%12.0f\t", (double)reps * BENCH_COUNT / (now() - str));
+
+    //sum: accAdd
+    for (reps = 0, str = now(); now() - str < BENCH_TIME; reps++) {
+      accInit(c);
+
+      for (i = 0; i < BENCH_COUNT; i++)
+        accAdd(c, &a[i], m);
+
+      accGet(&y, c, m);
+    }
+
+    printf("%12.0f\n", (double)reps * BENCH_COUNT / (now() - str));
+    equals(&r, &y, &ret);
+
+    if (ret != 0)
+      printf("  sums differ\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * batchbench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Batch benchmark (standalone mode). Adds BENCH_COUNT independent pairs, first with add over
+ *  arrays of BigInteger and then with BBadd over a BigBatch, on every SIMD level the CPU has
+ *  (scalar, AVX2 and AVX-512). Times are given on additions per second.
+ *
+ *  Build: gcc -O2 -x c -DBI_STANDALONE=1 -DCVALIDATE=0 -I.. batchbench.c ../BigInteger.cu ../BigLimb.c ../BigBatch.c -o batchbench
+ */
+#include "stdio.h"
+#include "stdlib.h"
+#include "time.h"
+#include "BigInteger.h"
+#include "BigBatch.h"
+
+//pairs on the batch
+#define BENCH_COUNT 20000
+
+//time budget for every measure, in seconds
+#define BENCH_TIME 0.3
+
+/*
+ * now. Wall time, in seconds.
+ */
+static double now() {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+int main() {
+  int sizes[] = { 18, 90, 400 };
+  int z = 0;
+  int i;
+  int j;
+  int n;
+  int l;
+  int reps;
+  char s[512];
+  void* m = malloc(getMemorySize());
+  BigInteger* a = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  BigInteger* b = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  BigBatch ba;
+  BigBatch bb;
+  double str;
+
+  init(m);
+  printf("digits\tadd\t\tscalar\t\tAVX2\t\tAVX-512\t(additions/s)\n");
+
+  for (; z < (int)(sizeof(sizes) / sizeof(int)); z++) {
+    n = sizes[z];
+
+    //a is positive and b negative (it's a subtraction on the BigInteger side too)
+    for (i = 0; i < BENCH_COUNT; i++) {
+      for (j = 0; j < n; j++)
+        s[j] = (char)('0' + (j == 0 ? 1 + rand() % 9 : rand() % 10));
+
+      s[n] = '\0';
+      newBI(&a[i], s, 0);
+      newBI(&b[i], s, -1);
+      b[i].n[0] = (signed char)(-(rand() % 10));
+
+      if (b[i].count == 0 && b[i].n[0] == 0)
+        b[i].n[0] = -1;
+    }
+
+    printf("%d\t", n);
+
+    //add (sign and carries are resolved per number); every pass adds b and then subtracts it
+    for (reps = 0, str = now(); now() - str < BENCH_TIME; reps++)
+      for (i = 0; i < BENCH_COUNT; i++) {
+        add(&a[i], &b[i], m);
+        sub(&a[i], &b[i], m);
+      }
+
+    printf("%12.0f\t", 2.0 * reps * BENCH_COUNT / (now() - str));
+
+    //BBadd, on every level
+    BBinit(&ba, BENCH_COUNT, n);
+    BBinit(&bb, BENCH_COUNT, n);
+
+    for (i = 0; i < BENCH_COUNT; i++) {
+      BBset(&ba, i, &a[i]);
+      BBset(&bb, i, &b[i]);
+    }
+
+    for (l = BB_SCALAR; l <= BB_AVX512; l++) {
+      if (BBsetSimd(l) != l) {
+        printf("%12s\t", "-");
+        continue;
+      }
+
+      for (reps = 0, str = now(); now() - str < BENCH_TIME; reps++) {
+        BBadd(&ba, &bb);
+        BBsub(&ba, &bb);
+      }
+
+      printf("%12.0f\t", 2.0 * reps * BENCH_COUNT / (now() - str));
+    }
+
+    printf("\n");
+    BBfree(&ba);
+    BBfree(&bb);
+  }
+
+  return 0;
+}
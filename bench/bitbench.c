@@ -0,0 +1,135 @@
+/*
+ * bitbench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Pinned operand benchmark (standalone mode). BENCH_COUNT numbers of 2n digits are multiplied and
+ *  divided by the same n digits number, first with mul and dvs and then with bitMul and bitDvs over
+ *  its BIT (built once). Results are checked. Times are given on operations per second.
+ *
+ *  Build: gcc -O2 -x c -DBI_STANDALONE=1 -DCVALIDATE=0 -I.. bitbench.c ../BigInteger.cu ../BigLimb.c -lpthread -o bitbench
+ */
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "stddef.h"
+#include "time.h"
+#include "BigInteger.h"
+
+//numbers on every pass
+#define BENCH_COUNT 1000
+
+//time budget for every measure, in seconds
+#define BENCH_TIME 0.3
+
+/*
+ * now. Wall time, in seconds.
+ */
+static double now() {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+/*
+ * rnd. Random number of n digits.
+ */
+static void rnd(BigInteger* x, int n) {
+  char s[4096];
+  int j = 0;
+
+  for (; j < n; j++)
+    s[j] = (char)('0' + (j == 0 ? 1 + rand() % 9 : rand() % 10));
+
+  s[n] = '\0';
+  newBI(x, s, 0);
+}
+
+/*
+ * load. Copies src on dst, moving only the digits in use (the ones above count shall stay on 0).
+ */
+static void load(BigInteger* dst, BigInteger* src) {
+  if (dst->count > src->count)
+    memset(dst->n + src->count + 1, 0, (size_t)(dst->count - src->count));
+
+  memcpy(dst, src, offsetof(BigInteger, n) + (size_t)src->count + 1);
+}
+
+int main() {
+  int sizes[] = { 18, 90, 400, 1000 };
+  int z = 0;
+  int i;
+  int k;
+  int n;
+  int reps;
+  int ret;
+  void* m = malloc(getMemorySize());
+  void* t = malloc(getBITSize());
+  BigInteger* a = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  BigInteger* x = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  BigInteger* y = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  BigInteger b;
+  double str;
+
+  init(m);
+
+  for (i = 0; i < BENCH_COUNT; i++) {
+    clean(&x[i]);
+    clean(&y[i]);
+  }
+
+  printf("digits\top\tmul/dvs\t\tbitMul/bitDvs\t(operations/s)\n");
+
+  for (; z < (int)(sizeof(sizes) / sizeof(int)); z++) {
+    n = sizes[z];
+    rnd(&b, n);
+
+    for (i = 0; i < BENCH_COUNT; i++)
+      rnd(&a[i], 2 * n);
+
+    bitInit(t, &b, m);
+
+    for (k = 0; k < 2; k++) {
+      printf("%d\t%c\t", n, k == 0 ? '*' : '/');
+
+      //a fresh copy of the numbers is taken on every pass
+      for (reps = 0, str = now(); now() - str < BENCH_TIME; reps++)
+        for (i = 0; i < BENCH_COUNT; i++) {
+          load(&x[i], &a[i]);
+
+          if (k == 0)
+            mul(&x[i], &b, m);
+          else
+            dvs(&x[i], &b, m);
+        }
+
+      printf("%12.0f\t", (double)reps * BENCH_COUNT / (now() - str));
+
+      for (reps = 0, str = now(); now() - str < BENCH_TIME; reps++)
+        for (i = 0; i < BENCH_COUNT; i++) {
+          load(&y[i], &a[i]);
+
+          if (k == 0)
+            bitMul(&y[i], &b, t, m);
+          else
+            bitDvs(&y[i], &b, t, m);
+        }
+
+      printf("%12.0f\n", (double)reps * BENCH_COUNT / (now() - str));
+
+      for (i = 0; i < BENCH_COUNT; i++) {
+        equals(&x[i], &y[i], &ret);
+
+        if (ret != 0) {
+          printf("  results differ\n");
+          break;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * cubench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Benchmark for the host backend of the CU* kernels (CUDA_ENABLED 2). A batch of pairs is
+ *  multiplied (CUsMul) and divided (CUsDvs), first calling the kernels one after another and then
+ *  launching them with CU_LAUNCH on a grid of BENCH_BLOCKS x BENCH_THREADS, so C_CU_THREADS can be
+ *  checked on the target machine. Times are given on operations per second.
+ *
+ *  Build: gcc -O3 -x c -DBI_STANDALONE=1 -DCUDA_ENABLED=2 -I.. cubench.c ../BigInteger.cu ../BigLimb.c -lpthread -o cubench
+ */
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include "BigInteger.h"
+
+//numbers on the batch
+#define BENCH_COUNT 2000
+
+//grid
+#define BENCH_BLOCKS 64
+#define BENCH_THREADS 32
+
+//kernel arguments
+typedef struct batch {
+  BigInteger* a;
+  BigInteger* b;
+  BigInteger* x;
+  BigInteger* y;
+  char op;
+  int n;
+} batch;
+
+/*
+ * now. Wall time, in seconds.
+ */
+static double now() {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+/*
+ * run. Runs the operation of the batch on item i.
+ */
+static void run(batch* j, int i) {
+  if (j->op == '*')
+    CUsMul(&j->a[i], &j->b[i], &j->x[i], &j->y[i]);
+  else
+    CUsDvs(&j->a[i], &j->b[i], &j->x[i], &j->y[i]);
+}
+
+/*
+ * kernel. Grid-stride loop over the batch.
+ */
+__global__ void kernel(void* vj) {
+  batch* j = (batch*)vj;
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+  for (; i < j->n; i += blockDim.x * gridDim.x)
+    run(j, i);
+}
+
+int main() {
+  int sizes[] = { 20, 100, 400 };
+  int z = 0;
+  int i;
+  int k;
+  int n;
+  char* s = (char*)malloc(1024);
+  BigInteger* a = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  BigInteger* b = (BigInteger*)malloc(sizeof(BigInteger) * BENCH_COUNT);
+  double str;
+  batch j;
+
+  j.n = BENCH_COUNT;
+  h2d((void**)&j.x, a, BENCH_COUNT, sizeof(BigInteger));
+  h2d((void**)&j.y, a, BENCH_COUNT, sizeof(BigInteger));
+
+  printf("digits\top\tcalls\t\tCU_LAUNCH\t(operations/s)\n");
+
+  for (; z < (int)(sizeof(sizes) / sizeof(int)); z++) {
+    n = sizes[z];
+
+    //random pairs, b with half the digits of a
+    for (i = 0; i < BENCH_COUNT; i++) {
+      for (k = 0; k < n; k++)
+        s[k] = (char)('0' + (k == 0 ? 1 + rand() % 9 : rand() % 10));
+
+      s[n] = '\0';
+      newBI(&a[i], s, 0);
+      s[n / 2] = '\0';
+      newBI(&b[i], s, 0);
+    }
+
+    for (k = 0; k < 2; k++) {
+      j.op = k == 0 ? '*' : '/';
+      printf("%d\t%c\t", n, j.op);
+
+      //one after another
+      h2d((void**)&j.a, a, BENCH_COUNT, sizeof(BigInteger));
+      h2d((void**)&j.b, b, BENCH_COUNT, sizeof(BigInteger));
+      str = now();
+
+      for (i = 0; i < BENCH_COUNT; i++)
+        run(&j, i);
+
+      printf("%12.0f\t", BENCH_COUNT / (now() - str));
+      dFree(j.a);
+      dFree(j.b);
+
+      //launched
+      h2d((void**)&j.a, a, BENCH_COUNT, sizeof(BigInteger));
+      h2d((void**)&j.b, b, BENCH_COUNT, sizeof(BigInteger));
+      str = now();
+
+      CU_LAUNCH(kernel, BENCH_BLOCKS, BENCH_THREADS, &j);
+
+      printf("%12.0f\n", BENCH_COUNT / (now() - str));
+      dFree(j.a);
+      dFree(j.b);
+    }
+  }
+
+  dFree(j.x);
+  dFree(j.y);
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * divbench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Division benchmark for the limb engine. Times schoolbook division (Knuth D) against
+ *  the Newton reciprocal path for a 2n / n limbs division, so the crossover point (and
+ *  the C_DIV_NEWTON_THRESHOLD value) can be checked on the target machine.
+ *
+ *  BigLimb.c is included so both paths can be called directly.
+ *
+ *  Build: gcc -O2 -I.. divbench.c -o divbench
+ */
+#include "stdio.h"
+#include "stdlib.h"
+#include "time.h"
+#include "../BigLimb.c"
+
+//time budget for every measure, in seconds
+#define BENCH_TIME 0.2
+
+/*
+ * knuth. Normalizes the operands and runs schoolbook division.
+ */
+static void knuth(BLlimb* q, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  BLlimb d = BL_BASE / (b[nb - 1] + 1);
+  BLlimb* u = scr;
+  BLlimb* v = u + na + 2;
+
+  memset(u, 0, sizeof(BLlimb) * (na + 2 + nb));
+  u[na] = lMac(u, a, na, d);
+  lMac(v, b, nb, d);
+
+  lDivKnuth(q, u, na + 1, v, nb);
+}
+
+/*
+ * newton. Normalizes the operands, gets the reciprocal (as lDivRem does) and runs division with it.
+ */
+static void newton(BLlimb* q, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  BLlimb d = BL_BASE / (b[nb - 1] + 1);
+  BLlimb* u = scr;
+  BLlimb* v = u + na + 2;
+  BLlimb* mu = v + nb;
+
+  memset(u, 0, sizeof(BLlimb) * (na + 2 + nb));
+  u[na] = lMac(u, a, na, d);
+  lMac(v, b, nb, d);
+
+  lInv(mu, v, nb, mu + nb + 1);
+  lDivBarrett(q, u, na + 1, v, nb, mu, mu + nb + 1);
+}
+
+typedef void (*divFn)(BLlimb* q, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr);
+
+/*
+ * timeDiv. Returns the microseconds that a 2n / n limbs division takes.
+ */
+static double timeDiv(divFn f, BLlimb* q, BLlimb* a, BLlimb* b, int n, BLlimb* scr) {
+  clock_t str = clock();
+  clock_t end;
+  int it = 0;
+
+  do {
+    f(q, a, 2 * n, b, n, scr);
+    ++it;
+    end = clock();
+  } while ((double)(end - str) / CLOCKS_PER_SEC < BENCH_TIME);
+
+  return 1e6 * (double)(end - str) / CLOCKS_PER_SEC / it;
+}
+
+int main() {
+  int sizes[] = { 8, 16, 32, 48, 64, 96, 128, 256, 512, 1024, 2048, 4096, 8192 };
+  int z = 0;
+  int i;
+  int n;
+  int s;
+  BLlimb* a;
+  BLlimb* b;
+  BLlimb* q;
+  BLlimb* scr;
+
+  printf("limbs\tdigits\tknuth\t\tnewton\t(us)\n");
+
+  for (; z < (int)(sizeof(sizes) / sizeof(int)); z++) {
+    n = sizes[z];
+
+    //room for the Newton path even below the threshold
+    s = 3 * n + 2 + (n + 1) + (2 * n + 2) + 2 * lInvScratch(n) + 4 * lScratch(2 * n + 2) + 64 * n;
+
+    a = (BLlimb*)malloc(sizeof(BLlimb) * 2 * n);
+    b = (BLlimb*)malloc(sizeof(BLlimb) * n);
+    q = (BLlimb*)malloc(sizeof(BLlimb) * (n + 2));
+    scr = (BLlimb*)malloc(sizeof(BLlimb) * s);
+
+    for (i = 0; i < 2 * n; i++)
+      a[i] = (BLlimb)(((BLdlimb)rand() * RAND_MAX + rand()) % BL_BASE);
+
+    for (i = 0; i < n; i++)
+      b[i] = (BLlimb)(((BLdlimb)rand() * RAND_MAX + rand()) % BL_BASE);
+
+    printf("%d\t%d\t", n, n * BL_DIGITS);
+    printf("%12.1f\t", timeDiv(knuth, q, a, b, n, scr));
+    printf("%12.1f\n", timeDiv(newton, q, a, b, n, scr));
+
+    free(a);
+    free(b);
+    free(q);
+    free(scr);
+  }
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * mulbench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Multiplication benchmark for the limb engine. Times every multiplication tier
+ *  (schoolbook, Karatsuba, Toom-3 and NTT) over balanced operands, so the crossover
+ *  points (and the C_KARA_THRESHOLD, C_TOOM_THRESHOLD and C_NTT_THRESHOLD values) can
+ *  be checked on the target machine. The last columns time squaring (schoolbook
+ *  squaring and the dispatched lSqr), to check C_KARA_SQR_THRESHOLD.
+ *
+ *  BigLimb.c is included so the tiers can be called directly. NTT is disabled on the
+ *  dispatcher, so Karatsuba and Toom-3 only recurse on the lower tiers.
+ *
+ *  Build: gcc -O2 -I.. mulbench.c -o mulbench
+ */
+#define C_NTT_THRESHOLD 0x7fffffff
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "time.h"
+#include "../BigLimb.c"
+
+//time budget for every measure, in seconds
+#define BENCH_TIME 0.2
+
+typedef void (*mulFn)(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr);
+
+/*
+ * basecase. Wrapper to give schoolbook the same signature as the other tiers.
+ */
+static void basecase(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  lMulBasecase(r, a, na, b, nb);
+}
+
+/*
+ * sqrcase. Wrapper to give schoolbook squaring the same signature as the other tiers.
+ */
+static void sqrcase(BLlimb* r, BLlimb* a, int na, BLlimb* b, int nb, BLlimb* scr) {
+  lSqrBasecase(r, a, na);
+}
+
+/*
+ * timeMul. Returns the microseconds that a n limbs multiplication takes.
+ */
+static double timeMul(mulFn f, BLlimb* r, BLlimb* a, BLlimb* b, int n, BLlimb* scr) {
+  clock_t str = clock();
+  clock_t end;
+  int it = 0;
+
+  do {
+    f(r, a, n, b, n, scr);
+    ++it;
+    end = clock();
+  } while ((double)(end - str) / CLOCKS_PER_SEC < BENCH_TIME);
+
+  return 1e6 * (double)(end - str) / CLOCKS_PER_SEC / it;
+}
+
+int main() {
+  int sizes[] = { 16, 32, 64, 128, 256, 384, 512, 768, 1024, 2048, 4096, 8192, 16384, 32768, 65536 };
+  int z = 0;
+  int i;
+  int n;
+  int s;
+  BLlimb* a;
+  BLlimb* b;
+  BLlimb* r;
+  BLlimb* scr;
+
+  printf("limbs\tdigits\tbasecase\tkaratsuba\ttoom-3\t\tntt\t\tsqr-base\tsqr\t(us)\n");
+
+  for (; z < (int)(sizeof(sizes) / sizeof(int)); z++) {
+    n = sizes[z];
+    s = lScratch(n);
+
+    if (s < 5 * lNttLen(2 * n))
+      s = 5 * lNttLen(2 * n);
+
+    a = (BLlimb*)malloc(sizeof(BLlimb) * n);
+    b = (BLlimb*)malloc(sizeof(BLlimb) * n);
+    r = (BLlimb*)malloc(sizeof(BLlimb) * 2 * n);
+    scr = (BLlimb*)malloc(sizeof(BLlimb) * s);
+
+    for (i = 0; i < n; i++) {
+      a[i] = (BLlimb)(((BLdlimb)rand() * RAND_MAX + rand()) % BL_BASE);
+      b[i] = (BLlimb)(((BLdlimb)rand() * RAND_MAX + rand()) % BL_BASE);
+    }
+
+    printf("%d\t%d\t", n, n * BL_DIGITS);
+
+    //schoolbook is skipped when it gets too slow
+    if (n <= 8192)
+      printf("%12.1f\t", timeMul(basecase, r, a, b, n, scr));
+    else
+      printf("%12s\t", "-");
+
+    printf("%12.1f\t", timeMul(lMulKara, r, a, b, n, scr));
+    printf("%12.1f\t", timeMul(lMulToom, r, a, b, n, scr));
+
+    printf("%12.1f\t", timeMul(lMulNtt, r, a, b, n, scr));
+
+    //squaring: b is a
+    if (n <= 8192)
+      printf("%12.1f\t", timeMul(sqrcase, r, a, a, n, scr));
+    else
+      printf("%12s\t", "-");
+
+    printf("%12.1f\n", timeMul(lMul, r, a, a, n, scr));
+
+    free(a);
+    free(b);
+    free(r);
+    free(scr);
+  }
+
+  return 0;
+}
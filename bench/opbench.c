@@ -0,0 +1,117 @@
+/*
+ * opbench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Operation benchmark for BigInteger (standalone mode). Times the public functions over
+ *  small and medium operands, where the cost of moving whole BigIntegers (C_MAX_LENGTH
+ *  bytes each) weighs more than the arithmetic itself.
+ *
+ *  Every measure leaves the operands as they were: add is followed by sub, mul by dvs,
+ *  and divmod writes on its own outputs.
+ *
+ *  Build: gcc -O2 -x c -DBI_STANDALONE=1 -I.. opbench.c ../BigInteger.cu ../BigLimb.c -o opbench
+ */
+#include "stdio.h"
+#include "stdlib.h"
+#include "time.h"
+#include "BigInteger.h"
+
+//time budget for every measure, in seconds
+#define BENCH_TIME 0.2
+
+//operations between clock readings
+#define BENCH_STEP 64
+
+/*
+ * fill. Generates a random positive number of n digits.
+ */
+static void fill(void* va, char* s, int n) {
+  int i = 1;
+
+  s[0] = (char)('1' + rand() % 9);
+
+  for (; i < n; i++)
+    s[i] = (char)('0' + rand() % 10);
+
+  s[n] = '\0';
+
+  newBI(va, s, 0);
+}
+
+int main() {
+  int sizes[] = { 9, 18, 36, 100, 300, 1000 };
+  int z = 0;
+  int i;
+  int it;
+  int n;
+  clock_t str;
+  clock_t end;
+  char s[2048];
+  BigInteger a;
+  BigInteger b;
+  BigInteger q;
+  BigInteger r;
+  memory* m = (memory*)malloc(getMemorySize());
+
+  init((void**)m);
+  newBI(&q, "0", 0);
+  newBI(&r, "0", 0);
+
+  printf("digits\tadd+sub\t\tmul+dvs\t\tdivmod\t(ns)\n");
+
+  for (; z < (int)(sizeof(sizes) / sizeof(int)); z++) {
+    n = sizes[z];
+
+    fill(&a, s, 2 * n);
+    fill(&b, s, n);
+
+    printf("%d\t", n);
+
+    it = 0;
+    str = clock();
+
+    do {
+      for (i = 0; i < BENCH_STEP; i++) {
+        add(&a, &b, m);
+        sub(&a, &b, m);
+      }
+
+      it += BENCH_STEP;
+      end = clock();
+    } while ((double)(end - str) / CLOCKS_PER_SEC < BENCH_TIME);
+
+    printf("%12.1f\t", 1e9 * (double)(end - str) / CLOCKS_PER_SEC / it);
+
+    it = 0;
+    str = clock();
+
+    do {
+      for (i = 0; i < BENCH_STEP; i++) {
+        mul(&a, &b, m);
+        dvs(&a, &b, m);
+      }
+
+      it += BENCH_STEP;
+      end = clock();
+    } while ((double)(end - str) / CLOCKS_PER_SEC < BENCH_TIME);
+
+    printf("%12.1f\t", 1e9 * (double)(end - str) / CLOCKS_PER_SEC / it);
+
+    it = 0;
+    str = clock();
+
+    do {
+      for (i = 0; i < BENCH_STEP; i++)
+        divmod(&q, &r, &a, &b, m);
+
+      it += BENCH_STEP;
+      end = clock();
+    } while ((double)(end - str) / CLOCKS_PER_SEC < BENCH_TIME);
+
+    printf("%12.1f\n", 1e9 * (double)(end - str) / CLOCKS_PER_SEC / it);
+  }
+
+  return 0;
+}
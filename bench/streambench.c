@@ -0,0 +1,134 @@
+/*
+ * streambench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: DoHITB under MIT License
+ *
+ *  Stream benchmark for BigInteger (standalone mode). Writes a file of random numbers (one per
+ *  line) and reads it back, first with fgets + newBI and toString + fwrite, and then with the
+ *  BigStream reader (mapped file) and writer. Times are given on numbers per second. The reader
+ *  is timed from BSopen (BSreadRate), so mapping and loading the file are included, as reading it
+ *  is on fgets.
+ *
+ *  On 200000 numbers (one run, it changes from run to run):
+ *    digits  fgets+newBI  BSnext    toString+fwrite  BSwrite
+ *    9       9.1M         13.6M     18.4M            42.4M
+ *    40      5.8M         9.6M      8.8M             15.4M
+ *    300     1.5M         3.0M      1.7M             2.0M
+ *
+ *  Build: gcc -O2 -x c -DBI_STANDALONE=1 -DCVALIDATE=0 -I.. streambench.c ../BigInteger.cu ../BigLimb.c ../BigStream.c -o streambench
+ */
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include "fcntl.h"
+#include "unistd.h"
+#include "BigInteger.h"
+#include "BigStream.h"
+
+//numbers on the file
+#define BENCH_COUNT 200000
+
+//writer buffer
+#define BENCH_BUF (1 << 16)
+
+/*
+ * now. Wall time, in seconds.
+ */
+static double now() {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+  int sizes[] = { 9, 40, 300 };
+  int z = 0;
+  int i;
+  int j;
+  int n;
+  int fd;
+  double str;
+  char* path = argc > 1 ? argv[1] : "streambench.txt";
+  char* s;
+  char* buf = (char*)malloc(BENCH_BUF);
+  FILE* f;
+  BigInteger a;
+  BSreader r;
+  BSwriter w;
+
+  iniStr(&s);
+
+  printf("digits\tfgets+newBI\tBSnext\t\ttoString+fwrite\tBSwrite\t(numbers/s)\n");
+
+  for (; z < (int)(sizeof(sizes) / sizeof(int)); z++) {
+    n = sizes[z];
+
+    //random numbers, one per line
+    f = fopen(path, "w");
+
+    for (i = 0; i < BENCH_COUNT; i++) {
+      s[0] = (char)('1' + rand() % 9);
+
+      for (j = 1; j < n; j++)
+        s[j] = (char)('0' + rand() % 10);
+
+      s[n] = '\n';
+      fwrite(s, 1, n + 1, f);
+    }
+
+    fclose(f);
+    printf("%d\t", n);
+
+    //fgets + newBI
+    f = fopen(path, "r");
+    str = now();
+
+    while (fgets(s, MAX_LENGTH + 2, f) != NULL) {
+      s[strcspn(s, "\n")] = '\0';
+      newBI(&a, s, 0);
+    }
+
+    printf("%12.0f\t", BENCH_COUNT / (now() - str));
+    fclose(f);
+
+    //BSnext
+    BSopen(&r, path);
+
+    while (BSnext(&r, &a) == 1);
+
+    printf("%12.0f\t", BSreadRate(&r));
+    BSclose(&r);
+
+    //toString + fwrite
+    f = fopen(path, "w");
+    str = now();
+
+    for (i = 0; i < BENCH_COUNT; i++) {
+      toString(&a, s);
+      fwrite(s, 1, strlen(s), f);
+      fputc('\n', f);
+    }
+
+    fclose(f);
+    printf("%12.0f\t", BENCH_COUNT / (now() - str));
+
+    //BSwrite
+    fd = open(path, O_WRONLY | O_TRUNC);
+    BSwriterInit(&w, fd, buf, BENCH_BUF);
+
+    for (i = 0; i < BENCH_COUNT; i++)
+      BSwrite(&w, &a);
+
+    BSflush(&w);
+    printf("%12.0f\n", BSwriteRate(&w));
+    close(fd);
+  }
+
+  remove(path);
+
+  return 0;
+}